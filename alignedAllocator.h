@@ -0,0 +1,47 @@
+// ===================================================================
+//                        ALIGNED ALLOCATOR
+// ===================================================================
+//
+// std::allocator replacement that hands out memory aligned to a fixed
+// boundary (a cache line by default), for layouts that rely on one
+// node == one cache line, or I/O buffers that must be page aligned.
+//
+// Usage: std::vector<int, AlignedAllocator<int, 64>> v(n);
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+
+template <class T, size_t Alignment = 64>
+struct AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    using value_type = T;
+
+    template <class U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <class U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n == 0) return nullptr;
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+        void* p = ::operator new(n * sizeof(T), std::align_val_t(Alignment));
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <class U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <class U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
@@ -0,0 +1,193 @@
+// ===================================================================
+//              POINT-TO-POINT QUERY (ALT) BENCHMARK PROGRAM
+// ===================================================================
+//
+// Answers a batch of random source -> target queries on a
+// graph1.txt-style file three ways and compares them per query:
+//   * Dijkstra (radix heap) from the source, stopping at the target,
+//   * bidirectional Dijkstra (AltRouter without landmarks),
+//   * bidirectional A* with landmark lower bounds (altRouting.h).
+// Then it serves the whole batch on 1 ... all threads.
+//
+// Usage:
+//   ./altRouting                              graph1.txt, 1000 queries
+//   ./altRouting FILE [QUERIES [LANDMARKS]]   any graph1.txt-style file
+//   ./altRouting --generate FILE N M          write a random N-node,
+//                                             M-edge graph
+//
+// Key Notes:
+// - The first run selects the landmarks (default 8), computes their
+//   distances and saves them as FILE.alt; later runs map that file, as
+//   FILE.csr is mapped for the graph (see graphLoader.h). Rebuilding
+//   is reported, so a stale file is easy to spot.
+// - Every answer must equal Dijkstra's distance.
+// - Per query: latency (median / p99 over the batch) and nodes settled.
+//   The time to build the index is reported separately, once.
+// - The graphs --generate writes connect any two nodes in a few hops,
+//   so landmark bounds are weak there and ALT settles about as many
+//   nodes as bidirectional Dijkstra. On road-like graphs (grids,
+//   long shortest paths) it settles a small fraction of them.
+// - Times are appended to benchmark_results.csv with the number of
+//   arcs as InputSize.
+//
+// Build: g++ -O2 -pthread altRouting.cpp -o altRouting
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "altRouting.h"   // LandmarkIndex, AltRouter
+#include "benchmark.h"    // Shared timing harness + CSV writer
+#include "dijkstra.h"     // dijkstra<RadixHeap>()
+#include "graphLoader.h"  // loadGraphCached(), CsrView
+using namespace std;
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    if (argc == 5 && string(argv[1]) == "--generate") {
+        size_t nodes = stoull(argv[3]), edges = stoull(argv[4]);
+        if (!writeRandomGraphText(argv[2], nodes, edges, 100, 42)) {
+            cerr << "Error: could not write " << argv[2] << endl;
+            return 1;
+        }
+        cout << "Wrote " << edges << " edges over " << nodes << " nodes to " << argv[2] << endl;
+        return 0;
+    }
+
+    string file_name = argc > 1 ? argv[1] : "graph1.txt";
+    size_t num_queries = argc > 2 ? stoull(argv[2]) : 1000;
+    size_t num_landmarks = argc > 3 ? stoull(argv[3]) : 8;
+    unsigned max_threads = max(1u, thread::hardware_concurrency());
+    ThreadPool all_threads(max_threads);
+
+    // ---- load phase ----
+    LoadedGraph loaded;
+    GraphLoadInfo load_info;
+    if (!loadGraphCached(file_name, EdgeListFormat::CountThenEdges, loaded, &all_threads, &load_info)) return 1;
+    const CsrView& graph = loaded.view();
+    if (graph.nodeCount() == 0) {
+        cerr << "Error: " << file_name << " has no edges" << endl;
+        return 1;
+    }
+    if (!hasNonNegativeWeights(graph)) {
+        cerr << "Error: A* needs non-negative weights (use bellmanFord for " << file_name << ")" << endl;
+        return 1;
+    }
+    long long m = (long long)graph.arcCount();
+    cout << "Loaded " << file_name << ": " << graph.nodeCount() << " nodes, " << m << " arcs" << endl;
+
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    // ---- preprocessing (or mapping the saved index) ----
+    auto index_start = bench::Clock::now();
+    LandmarkLoadInfo index_info;
+    LandmarkIndex landmarks = loadOrBuildLandmarks(file_name, graph, num_landmarks, all_threads, &index_info);
+    double index_ns = bench::elapsedNs(index_start, bench::Clock::now());
+    auto router_start = bench::Clock::now();
+    AltRouter<CsrView> router(graph, landmarks);
+    double router_ns = bench::elapsedNs(router_start, bench::Clock::now());
+    cout << (index_info.fromFile ? "Mapped " : "Built ") << landmarks.count() << " landmarks ("
+         << (landmarks.symmetric() ? "undirected" : "directed") << ", " << fixed << setprecision(1)
+         << landmarks.memoryBytes() / 1048576.0 << " MiB) in " << setprecision(3) << index_ns / 1e6 << " ms"
+         << defaultfloat;
+    if (!index_info.fromFile) cout << (index_info.written ? ", saved to " : ", could not save ") << index_info.path;
+    cout << "\nRouter setup: " << fixed << setprecision(3) << router_ns / 1e6 << " ms" << defaultfloat << endl;
+    csv.write(bench::fromSamples(index_info.fromFile ? "ALT_index_open" : "ALT_index_build", m, {index_ns}));
+
+    // ---- queries: random pairs, fixed seed ----
+    mt19937_64 rng(42);
+    vector<pair<NodeId, NodeId>> queries(num_queries);
+    for (auto& q : queries) q = {(NodeId)(rng() % graph.nodeCount()), (NodeId)(rng() % graph.nodeCount())};
+
+    vector<Distance> expected(num_queries);
+    AltWorkspace workspace(graph.nodeCount());
+    struct Method {
+        string name, label;
+        vector<double> latency;
+        size_t settled = 0;
+    };
+    vector<Method> methods = {{"P2P_Dijkstra_RadixHeap", "Dijkstra (radix heap)", {}, 0},
+                              {"P2P_BidirectionalDijkstra", "Bidirectional Dijkstra", {}, 0},
+                              {"P2P_ALT_" + to_string(landmarks.count()), "Bidirectional ALT", {}, 0}};
+    for (size_t i = 0; i < num_queries; ++i) {
+        auto [s, t] = queries[i];
+        for (size_t k = 0; k < methods.size(); ++k) {
+            auto start = bench::Clock::now();
+            Distance d;
+            size_t settled;
+            if (k == 0) {
+                ShortestPaths sp = dijkstra<RadixHeap>(graph, s, t);
+                d = sp.dist[t];
+                settled = sp.settled;
+            } else {
+                AltQueryResult r = router.query(s, t, workspace, k == 2);
+                d = r.distance;
+                settled = r.settled;
+            }
+            methods[k].latency.push_back(bench::elapsedNs(start, bench::Clock::now()));
+            methods[k].settled += settled;
+            if (k == 0) {
+                expected[i] = d;
+            } else if (d != expected[i]) {
+                cerr << "Error: " << methods[k].label << " gives " << d << " for " << graph.names[s] << " -> "
+                     << graph.names[t] << ", Dijkstra " << expected[i] << endl;
+                return 1;
+            }
+        }
+    }
+
+    size_t reachable = count_if(expected.begin(), expected.end(), [](Distance d) { return d != kInfinity; });
+    cout << "\n--- " << num_queries << " random queries (" << reachable << " reachable) ---" << endl;
+    cout << left << setw(26) << "Method" << right << setw(14) << "median us" << setw(12) << "p99 us" << setw(16)
+         << "settled/query" << setw(12) << "speedup" << endl;
+    double dijkstra_median = 0;
+    for (Method& method : methods) {
+        bench::Stats stats = bench::fromSamples(method.name, m, method.latency);
+        if (dijkstra_median == 0) dijkstra_median = stats.medianNs;
+        cout << left << setw(26) << method.label << right << fixed << setprecision(2) << setw(14)
+             << stats.medianNs / 1e3 << setw(12) << stats.p99Ns / 1e3 << setw(16) << setprecision(1)
+             << (double)method.settled / (double)max<size_t>(1, num_queries) << setw(11) << setprecision(2)
+             << dijkstra_median / stats.medianNs << "x" << defaultfloat << endl;
+        csv.write(stats);
+    }
+
+    // ---- batches: the same queries on 1, 2, 4, ... and all threads ----
+    vector<unsigned> thread_counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 5;
+    cout << "\n--- Batch of " << num_queries << " ALT queries ---" << endl;
+    double one_thread_ns = 0;
+    for (unsigned t : thread_counts) {
+        ThreadPool pool(t);
+        vector<AltQueryResult> results;
+        bench::Stats stats = bench::measure("P2P_ALT_batch_t" + to_string(t), m, [&] {
+            results = router.queryBatch(queries, pool);
+        }, cfg);
+        for (size_t i = 0; i < num_queries; ++i) {
+            if (results[i].distance != expected[i]) {
+                cerr << "Error: batch answer " << i << " is wrong on " << t << " threads" << endl;
+                return 1;
+            }
+        }
+        if (t == 1) one_thread_ns = stats.medianNs;
+        cout << "threads=" << setw(3) << t << " " << fixed << setprecision(3) << setw(10) << stats.medianNs / 1e6
+             << " ms, " << setprecision(0) << setw(10) << (double)num_queries / stats.medianNs * 1e9
+             << " queries/s, speedup vs 1 thread = " << setprecision(2) << one_thread_ns / stats.medianNs << "x"
+             << defaultfloat << endl;
+        csv.write(stats);
+    }
+
+    cout << "\nAll answers match Dijkstra" << endl;
+    cout << "Results appended to " << csv.path() << endl;
+    return 0;
+}
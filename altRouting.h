@@ -0,0 +1,522 @@
+// ===================================================================
+//      POINT-TO-POINT QUERIES: BIDIRECTIONAL A* WITH LANDMARKS (ALT)
+// ===================================================================
+//
+// Answers many source -> target queries on one graph far faster than a
+// full Dijkstra each, after a one-time preprocessing step:
+//
+//   LandmarkIndex    -> k landmark nodes and the exact distances from
+//                       (and, on directed graphs, to) each of them,
+//                       saved as "<graph>.alt" next to the graph
+//   AltRouter        -> bidirectional A* search using lower bounds
+//                       derived from those distances
+//
+// Key Notes:
+// - Lower bounds (triangle inequality): for any landmark L,
+//       d(v, t) >= d(L, t) - d(L, v)   and   d(v, t) >= d(v, L) - d(t, L)
+//   The best of them over all landmarks steers each search towards
+//   the other end. When a distance is infinite the same inequalities
+//   prove that v cannot be on any s -> t path, and v is pruned.
+// - Landmarks are picked by FARTHEST selection: each new landmark is
+//   the node farthest from the ones already chosen, so they end up on
+//   the periphery, "behind" most targets.
+// - Both searches use the AVERAGE potential
+//       p(v) = (bound(v -> t) - bound(s -> v)) / 2
+//   (forward key d + p, backward key d - p). This keeps every reduced
+//   arc cost non-negative in both directions, and the searches can
+//   stop as soon as the smallest forward key plus the smallest
+//   backward key reach the best meeting distance found so far. Keys
+//   are stored doubled so that no division is needed.
+// - The index is node-major (the k distances of a node share a cache
+//   line for k = 8) and read-only, so any number of threads query it
+//   at once. Each thread brings an AltWorkspace; its arrays are reset
+//   by bumping a stamp, not by clearing n entries per query.
+// - The ".alt" file records the graph's size and a fingerprint of its
+//   arcs. A file that does not match is rebuilt, never trusted, and a
+//   matching one is mapped in place (like the CSR snapshots of
+//   graphLoader.h).
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "dijkstra.h"     // dijkstra(), QuadHeap, Distance, kInfinity
+#include "graph.h"
+#include "graphLoader.h"  // MappedFile, snapshot helpers
+#include "threadPool.h"
+
+namespace alt_detail {
+
+/**
+ * @brief Arc arrays with the member names dijkstra() expects.
+ */
+struct ArcLists {
+    std::vector<uint64_t> offsets;
+    std::vector<NodeId> targets;
+    std::vector<EdgeWeight> weights;
+
+    size_t nodeCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    size_t arcCount() const { return targets.size(); }
+};
+
+/**
+ * @brief The graph with every arc turned around.
+ */
+template <class Graph>
+ArcLists reverseOf(const Graph& graph) {
+    size_t n = graph.nodeCount();
+    ArcLists r;
+    r.offsets.assign(n + 1, 0);
+    for (size_t e = 0; e < graph.arcCount(); ++e) r.offsets[graph.targets[e] + 1]++;
+    for (size_t v = 0; v < n; ++v) r.offsets[v + 1] += r.offsets[v];
+    r.targets.resize(graph.arcCount());
+    r.weights.resize(graph.arcCount());
+    std::vector<uint64_t> fill(r.offsets.begin(), r.offsets.end() - 1);
+    for (size_t u = 0; u < n; ++u) {
+        for (uint64_t e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            uint64_t pos = fill[graph.targets[e]]++;
+            r.targets[pos] = (NodeId)u;
+            r.weights[pos] = graph.weights[e];
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief True if every node has the same (target, weight) arcs in
+ *        @p graph and in its reverse, i.e. the graph is undirected.
+ */
+template <class Graph>
+bool isSymmetric(const Graph& graph, const ArcLists& reverse) {
+    std::vector<std::pair<NodeId, EdgeWeight>> a, b;
+    for (size_t u = 0; u < graph.nodeCount(); ++u) {
+        a.clear();
+        b.clear();
+        for (uint64_t e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) a.push_back({graph.targets[e], graph.weights[e]});
+        for (uint64_t e = reverse.offsets[u]; e < reverse.offsets[u + 1]; ++e)
+            b.push_back({reverse.targets[e], reverse.weights[e]});
+        if (a.size() != b.size()) return false;
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        if (a != b) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 64-bit fingerprint of a graph's arcs (not cryptographic; it
+ *        tells a stale ".alt" file from a matching one).
+ */
+template <class Graph>
+uint64_t fingerprint(const Graph& graph) {
+    uint64_t h = 0x6A09E667F3BCC909ull;
+    auto add = [&h](uint64_t x) {
+        h = (h ^ x) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+    };
+    add(graph.nodeCount());
+    add(graph.arcCount());
+    for (size_t u = 0; u <= graph.nodeCount(); ++u) add(graph.offsets[u]);
+    for (size_t e = 0; e < graph.arcCount(); ++e) add((uint64_t)graph.targets[e] << 32 | (uint32_t)graph.weights[e]);
+    return h;
+}
+
+constexpr char kAltMagic[8] = {'A', 'L', 'T', 'I', 'N', 'D', 'X', '\0'};
+constexpr uint32_t kAltVersion = 1;
+
+/**
+ * @brief Fixed header of a ".alt" file; *At fields are byte offsets.
+ */
+struct AltHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t nodeCount;
+    uint64_t arcCount;
+    uint64_t graphHash;
+    uint32_t landmarkCount;
+    uint32_t symmetric;  // 1: the "to" distances equal the "from" ones
+    uint64_t landmarksAt, fromAt, toAt;
+};
+
+}  // namespace alt_detail
+
+// ===================================================================
+//                         LANDMARK INDEX
+// ===================================================================
+
+class LandmarkIndex {
+public:
+    LandmarkIndex() = default;
+    LandmarkIndex(const LandmarkIndex&) = delete;
+    LandmarkIndex& operator=(const LandmarkIndex&) = delete;
+    LandmarkIndex(LandmarkIndex&&) = default;  // vectors and mappings keep their buffers
+    LandmarkIndex& operator=(LandmarkIndex&&) = default;
+
+    /**
+     * @brief Picks @p count landmarks by farthest selection and computes
+     *        their distances. The backward searches of a directed graph
+     *        run in parallel on @p pool.
+     */
+    template <class Graph>
+    static LandmarkIndex build(const Graph& graph, size_t count, ThreadPool& pool) {
+        LandmarkIndex index;
+        size_t n = graph.nodeCount();
+        size_t k = std::min(count, n);
+        index.nodeCount_ = n;
+        index.graphHash_ = alt_detail::fingerprint(graph);
+        alt_detail::ArcLists reverse = alt_detail::reverseOf(graph);
+        index.symmetric_ = alt_detail::isSymmetric(graph, reverse);
+        index.fromVec_.assign(n * k, kInfinity);
+
+        // Farthest selection, starting from the node farthest from node 0.
+        // Nodes no landmark reaches yet count as the farthest of all.
+        std::vector<Distance> nearest(n, kInfinity);
+        NodeId next = 0;
+        if (n > 0) {
+            ShortestPaths sp = dijkstra<QuadHeap>(graph, 0);
+            for (size_t v = 0; v < n; ++v)
+                if (sp.dist[v] != kInfinity && sp.dist[v] > sp.dist[next]) next = (NodeId)v;
+        }
+        for (size_t i = 0; i < k; ++i) {
+            index.landmarks_.push_back(next);
+            ShortestPaths sp = dijkstra<QuadHeap>(graph, next);
+            for (size_t v = 0; v < n; ++v) {
+                index.fromVec_[v * k + i] = sp.dist[v];
+                nearest[v] = std::min(nearest[v], sp.dist[v]);
+            }
+            for (size_t v = 0; v < n; ++v)
+                if (nearest[v] > nearest[next]) next = (NodeId)v;
+        }
+
+        if (!index.symmetric_) {
+            index.toVec_.assign(n * k, kInfinity);
+            ThreadPool::TaskGroup group(pool);
+            for (size_t i = 0; i < k; ++i) {
+                group.run([&, i] {
+                    ShortestPaths sp = dijkstra<QuadHeap>(reverse, index.landmarks_[i]);
+                    for (size_t v = 0; v < n; ++v) index.toVec_[v * k + i] = sp.dist[v];
+                });
+            }
+            group.wait();
+        }
+        index.from_ = index.fromVec_.data();
+        index.to_ = index.symmetric_ ? index.from_ : index.toVec_.data();
+        return index;
+    }
+
+    /**
+     * @brief Saves the index (to "<path>.tmp", then renamed).
+     */
+    bool save(const std::string& path, uint64_t arcCount) const {
+        using namespace alt_detail;
+        using loader_detail::alignUp;
+        size_t k = landmarks_.size();
+        AltHeader h{};
+        std::memcpy(h.magic, kAltMagic, sizeof kAltMagic);
+        h.version = kAltVersion;
+        h.byteOrder = loader_detail::kByteOrderMark;
+        h.nodeCount = nodeCount_;
+        h.arcCount = arcCount;
+        h.graphHash = graphHash_;
+        h.landmarkCount = (uint32_t)k;
+        h.symmetric = symmetric_;
+        h.landmarksAt = alignUp(sizeof h);
+        h.fromAt = alignUp(h.landmarksAt + k * sizeof(NodeId));
+        h.toAt = symmetric_ ? h.fromAt : alignUp(h.fromAt + nodeCount_ * k * sizeof(Distance));
+
+        std::string tmp = path + ".tmp";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        uint64_t written = 0;
+        auto put = [&](uint64_t at, const void* data, size_t bytes) {
+            static const char zeros[loader_detail::kSectionAlign] = {};
+            out.write(zeros, (std::streamsize)(at - written));
+            out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+            written = at + bytes;
+        };
+        put(0, &h, sizeof h);
+        put(h.landmarksAt, landmarks_.data(), k * sizeof(NodeId));
+        put(h.fromAt, from_, nodeCount_ * k * sizeof(Distance));
+        if (!symmetric_) put(h.toAt, to_, nodeCount_ * k * sizeof(Distance));
+        out.close();
+
+        if (!out || std::rename(tmp.c_str(), path.c_str()) != 0) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Maps a file written by save() if it was built from exactly
+     *        this graph with @p count landmarks.
+     */
+    template <class Graph>
+    bool open(const std::string& path, const Graph& graph, size_t count) {
+        using namespace alt_detail;
+        MappedFile file;
+        if (!file.open(path) || file.size() < sizeof(AltHeader)) return false;
+        AltHeader h;
+        std::memcpy(&h, file.data(), sizeof h);
+        size_t k = std::min(count, graph.nodeCount());
+        if (std::memcmp(h.magic, kAltMagic, sizeof kAltMagic) != 0 || h.version != kAltVersion ||
+            h.byteOrder != loader_detail::kByteOrderMark || h.nodeCount != graph.nodeCount() ||
+            h.arcCount != graph.arcCount() || h.landmarkCount != k)
+            return false;
+        uint64_t table = h.nodeCount * k * sizeof(Distance);
+        auto fits = [&](uint64_t at, uint64_t bytes) {
+            return at % loader_detail::kSectionAlign == 0 && at <= file.size() && bytes <= file.size() - at;
+        };
+        if (!fits(h.landmarksAt, k * sizeof(NodeId)) || !fits(h.fromAt, table) || !fits(h.toAt, table)) return false;
+        if (h.graphHash != fingerprint(graph)) return false;
+
+        const NodeId* ids = reinterpret_cast<const NodeId*>(file.data() + h.landmarksAt);
+        landmarks_.assign(ids, ids + k);
+        fromVec_.clear();
+        toVec_.clear();
+        file_ = std::move(file);
+        nodeCount_ = h.nodeCount;
+        graphHash_ = h.graphHash;
+        symmetric_ = h.symmetric != 0;
+        from_ = reinterpret_cast<const Distance*>(file_.data() + h.fromAt);
+        to_ = reinterpret_cast<const Distance*>(file_.data() + h.toAt);
+        return true;
+    }
+
+    size_t count() const { return landmarks_.size(); }
+    const std::vector<NodeId>& landmarks() const { return landmarks_; }
+    bool symmetric() const { return symmetric_; }
+    bool isMapped() const { return file_.isOpen(); }
+
+    // d(landmark i, v) and d(v, landmark i) for i < count().
+    const Distance* fromRow(NodeId v) const { return from_ + (size_t)v * landmarks_.size(); }
+    const Distance* toRow(NodeId v) const { return to_ + (size_t)v * landmarks_.size(); }
+
+    /**
+     * @brief Bytes of distance tables.
+     */
+    size_t memoryBytes() const { return nodeCount_ * count() * sizeof(Distance) * (symmetric_ ? 1 : 2); }
+
+private:
+    MappedFile file_;  // mapped ".alt" file, or
+    std::vector<Distance> fromVec_, toVec_;  // built in memory
+    std::vector<NodeId> landmarks_;
+    const Distance* from_ = nullptr;
+    const Distance* to_ = nullptr;
+    size_t nodeCount_ = 0;
+    uint64_t graphHash_ = 0;
+    bool symmetric_ = true;
+};
+
+/**
+ * @brief How loadOrBuildLandmarks() got its index.
+ */
+struct LandmarkLoadInfo {
+    std::string path;
+    bool fromFile = false;  // mapped a matching ".alt" file
+    bool written = false;   // built and saved a new one
+};
+
+/**
+ * @brief Maps "<graphPath>.alt" if it matches the graph, otherwise
+ *        builds the index and saves it there for the next run.
+ */
+template <class Graph>
+LandmarkIndex loadOrBuildLandmarks(const std::string& graphPath, const Graph& graph, size_t count, ThreadPool& pool,
+                                   LandmarkLoadInfo* info = nullptr) {
+    LandmarkLoadInfo local;
+    LandmarkLoadInfo& result = info ? *info : local;
+    result = LandmarkLoadInfo();
+    result.path = graphPath + ".alt";
+
+    LandmarkIndex index;
+    if (index.open(result.path, graph, count)) {
+        result.fromFile = true;
+        return index;
+    }
+    index = LandmarkIndex::build(graph, count, pool);
+    result.written = index.save(result.path, graph.arcCount());
+    if (!result.written) std::cerr << "Note: could not write landmark file " << result.path << std::endl;
+    return index;
+}
+
+// ===================================================================
+//                      BIDIRECTIONAL A* QUERIES
+// ===================================================================
+
+/**
+ * @brief Answer to one point-to-point query.
+ */
+struct AltQueryResult {
+    Distance distance = kInfinity;  // kInfinity if unreachable
+    size_t settled = 0;             // nodes settled by both searches
+};
+
+/**
+ * @brief Per-thread scratch space of AltRouter::query().
+ */
+class AltWorkspace {
+public:
+    explicit AltWorkspace(size_t n) : dist_{std::vector<Distance>(n), std::vector<Distance>(n)},
+                                      stamp_{std::vector<uint32_t>(n, 0), std::vector<uint32_t>(n, 0)},
+                                      potential_(n), potentialStamp_(n, 0) {}
+
+private:
+    template <class Graph>
+    friend class AltRouter;
+
+    // A node is reached on a side when its stamp is >= base_, settled
+    // when it equals base_ + 1; every query moves base_ up by 2.
+    void nextQuery() {
+        if (base_ >= std::numeric_limits<uint32_t>::max() - 2) {
+            for (auto& s : stamp_) std::fill(s.begin(), s.end(), 0);
+            std::fill(potentialStamp_.begin(), potentialStamp_.end(), 0);
+            base_ = 0;
+        }
+        base_ += 2;
+        queue_[0].clear();
+        queue_[1].clear();
+    }
+
+    std::vector<Distance> dist_[2];    // forward, backward
+    std::vector<uint32_t> stamp_[2];
+    std::vector<Distance> potential_;  // doubled potential, kInfinity = pruned
+    std::vector<uint32_t> potentialStamp_;
+    QuadHeap queue_[2];
+    uint32_t base_ = 0;
+};
+
+template <class Graph>
+class AltRouter {
+public:
+    /**
+     * @brief Router over @p graph; both must outlive it. A directed graph
+     *        also gets a reversed copy for the backward search.
+     */
+    AltRouter(const Graph& graph, const LandmarkIndex& landmarks) : graph_(graph), landmarks_(landmarks) {
+        side_[0] = {graph.offsets.data(), graph.targets.data(), graph.weights.data()};
+        if (landmarks.symmetric()) {
+            side_[1] = side_[0];
+        } else {
+            reverse_ = alt_detail::reverseOf(graph);
+            side_[1] = {reverse_.offsets.data(), reverse_.targets.data(), reverse_.weights.data()};
+        }
+    }
+
+    size_t nodeCount() const { return graph_.nodeCount(); }
+
+    /**
+     * @brief Shortest distance from @p s to @p t.
+     * @param useLandmarks false = plain bidirectional Dijkstra.
+     */
+    AltQueryResult query(NodeId s, NodeId t, AltWorkspace& ws, bool useLandmarks = true) const {
+        AltQueryResult result;
+        if (s == t) {
+            result.distance = 0;
+            return result;
+        }
+        ws.nextQuery();
+        const uint32_t base = ws.base_;
+        const size_t k = useLandmarks ? landmarks_.count() : 0;
+
+        // Doubled average potential of v, or kInfinity if v cannot be
+        // on an s -> t path.
+        auto potential = [&](NodeId v) {
+            if (ws.potentialStamp_[v] == base) return ws.potential_[v];
+            ws.potentialStamp_[v] = base;
+            return ws.potential_[v] = averagePotential(v, s, t, k);
+        };
+
+        Distance mu = kInfinity;
+        if (potential(s) == kInfinity || potential(t) == kInfinity) return result;
+        for (int d = 0; d < 2; ++d) {
+            NodeId start = d == 0 ? s : t;
+            ws.dist_[d][start] = 0;
+            ws.stamp_[d][start] = base;
+            ws.queue_[d].push(d == 0 ? potential(s) : -potential(t), start);
+        }
+
+        while (!ws.queue_[0].empty() && !ws.queue_[1].empty()) {
+            Distance top0 = ws.queue_[0].topKey(), top1 = ws.queue_[1].topKey();
+            if (mu != kInfinity && top0 + top1 >= 2 * mu) break;
+            int d = top0 <= top1 ? 0 : 1;
+            NodeId u = ws.queue_[d].pop().second;
+            if (ws.stamp_[d][u] == base + 1) continue;  // stale entry
+            ws.stamp_[d][u] = base + 1;
+            ++result.settled;
+
+            const Side& side = side_[d];
+            Distance du = ws.dist_[d][u];
+            for (uint64_t e = side.offsets[u]; e < side.offsets[u + 1]; ++e) {
+                NodeId v = side.targets[e];
+                Distance nd = du + side.weights[e];
+                bool reached = ws.stamp_[d][v] >= base;
+                if (reached && nd >= ws.dist_[d][v]) continue;
+                Distance p = potential(v);
+                if (p == kInfinity) continue;
+                if (!reached) ws.stamp_[d][v] = base;
+                ws.dist_[d][v] = nd;
+                ws.queue_[d].push(2 * nd + (d == 0 ? p : -p), v);
+                if (ws.stamp_[1 - d][v] >= base) mu = std::min(mu, nd + ws.dist_[1 - d][v]);
+            }
+        }
+        result.distance = mu;
+        return result;
+    }
+
+    /**
+     * @brief Answers every (source, target) pair on the threads of
+     *        @p pool: one workspace per thread, queries handed out one
+     *        at a time.
+     */
+    std::vector<AltQueryResult> queryBatch(const std::vector<std::pair<NodeId, NodeId>>& queries, ThreadPool& pool,
+                                           bool useLandmarks = true) const {
+        std::vector<AltQueryResult> results(queries.size());
+        std::atomic<size_t> next{0};
+        pool.parallelFor(0, pool.size(), 1, [&](size_t lo, size_t hi) {
+            AltWorkspace ws(nodeCount());
+            for (size_t lane = lo; lane < hi; ++lane)
+                for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < queries.size();)
+                    results[i] = query(queries[i].first, queries[i].second, ws, useLandmarks);
+        });
+        return results;
+    }
+
+private:
+    struct Side {
+        const uint64_t* offsets;
+        const NodeId* targets;
+        const EdgeWeight* weights;
+    };
+
+    /**
+     * @brief (bound(v -> t) - bound(s -> v)) over the first k landmarks,
+     *        or kInfinity when a bound is infinite.
+     */
+    Distance averagePotential(NodeId v, NodeId s, NodeId t, size_t k) const {
+        const Distance *fromV = landmarks_.fromRow(v), *toV = landmarks_.toRow(v);
+        const Distance *fromS = landmarks_.fromRow(s), *toS = landmarks_.toRow(s);
+        const Distance *fromT = landmarks_.fromRow(t), *toT = landmarks_.toRow(t);
+        Distance toTarget = 0, fromSource = 0;
+        for (size_t i = 0; i < k; ++i) {
+            // L reaches v but not t, or t reaches L but v does not: v cannot reach t.
+            if ((fromT[i] == kInfinity && fromV[i] != kInfinity) || (toV[i] == kInfinity && toT[i] != kInfinity))
+                return kInfinity;
+            // L reaches s but not v, or v reaches L but s does not: s cannot reach v.
+            if ((fromV[i] == kInfinity && fromS[i] != kInfinity) || (toS[i] == kInfinity && toV[i] != kInfinity))
+                return kInfinity;
+            if (fromV[i] != kInfinity) toTarget = std::max(toTarget, fromT[i] - fromV[i]);
+            if (toT[i] != kInfinity) toTarget = std::max(toTarget, toV[i] - toT[i]);
+            if (fromS[i] != kInfinity) fromSource = std::max(fromSource, fromV[i] - fromS[i]);
+            if (toV[i] != kInfinity) fromSource = std::max(fromSource, toS[i] - toV[i]);
+        }
+        return toTarget - fromSource;
+    }
+
+    const Graph& graph_;
+    const LandmarkIndex& landmarks_;
+    alt_detail::ArcLists reverse_;  // directed graphs only
+    Side side_[2];
+};
@@ -0,0 +1,297 @@
+// ===================================================================
+//            B+ TREE vs SORTED ARRAY BENCHMARK (MIXED LOAD)
+// ===================================================================
+//
+// An ordered set of N distinct ints under a stream of lookups mixed
+// with inserts and erases, kept in:
+//   * BPlusTree (bPlusTree.h): O(log n) updates in place,
+//   * SortedVector: insert / erase at std::lower_bound, shifting the
+//     tail of the array (O(n) per update),
+//   * ReSort: updates are buffered; the first lookup after them
+//     re-sorts the array (and drops erased keys), then binarySearch().
+//
+// Usage: ./bPlusTree [N]     (default N = 1000000)
+//
+// Key Notes:
+// - Write ratios 0%, 1%, 10% and 50%: writes alternate between
+//   inserting a new key and erasing a present one, every other
+//   operation is find() on a random key (about half of them present).
+// - Every structure replays the same operation stream from the same
+//   start. The slow ones replay a shorter prefix of it (a fixed budget
+//   of writes), so times are reported per OPERATION.
+// - Then range scans: every key in [lo, lo + width) for widths of
+//   ~10 ... ~10000 keys, tree leaf walk vs sorted array. Long scans
+//   favour the array: one contiguous run instead of a hop per leaf.
+// - Every run is replayed on a std::set: same hits, same final set.
+//
+// Build: g++ -O2 -march=native bPlusTree.cpp -o bPlusTree
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"         // Shared timing harness + CSV writer
+#include "binarySearch.h"      // binarySearch()
+#include "bPlusTree.h"         // BPlusTree
+#include "datasetGenerator.h"  // loadDataset()
+using namespace std;
+
+struct Op {
+    enum Kind : uint8_t { Find, Insert, Erase } kind;
+    int key;
+};
+
+/**
+ * @brief Result of replaying operations: lookups that hit, final keys.
+ */
+struct Outcome {
+    size_t hits = 0;
+    vector<int> keys;
+    bool operator==(const Outcome& other) const { return hits == other.hits && keys == other.keys; }
+};
+
+// ===================================================================
+//                      THE THREE STRUCTURES
+// ===================================================================
+
+struct TreeSet {
+    BPlusTree<int> tree;
+    void reset(const vector<int>& keys) { tree.assignSorted(keys.data(), keys.data(), keys.size()); }
+    bool find(int key) { return tree.find(key) != nullptr; }
+    void insert(int key) { tree.insert(key, key); }
+    void erase(int key) { tree.erase(key); }
+    vector<int> keys() {
+        vector<int> out;
+        for (auto it = tree.begin(); it != tree.end(); ++it) out.push_back(it.key());
+        return out;
+    }
+};
+
+struct SortedVectorSet {
+    vector<int> a;
+    void reset(const vector<int>& keys) { a = keys; }
+    bool find(int key) { return binarySearch(a, key) >= 0; }
+    void insert(int key) {
+        auto it = lower_bound(a.begin(), a.end(), key);
+        if (it == a.end() || *it != key) a.insert(it, key);
+    }
+    void erase(int key) {
+        auto it = lower_bound(a.begin(), a.end(), key);
+        if (it != a.end() && *it == key) a.erase(it);
+    }
+    vector<int> keys() { return a; }
+};
+
+struct ReSortSet {
+    vector<int> a, erased;
+    bool dirty = false;
+    void reset(const vector<int>& keys) {
+        a = keys;
+        erased.clear();
+        dirty = false;
+    }
+    void rebuild() {
+        sort(a.begin(), a.end());
+        a.erase(unique(a.begin(), a.end()), a.end());
+        if (!erased.empty()) {
+            sort(erased.begin(), erased.end());
+            a.erase(remove_if(a.begin(), a.end(),
+                              [&](int k) { return binary_search(erased.begin(), erased.end(), k); }),
+                    a.end());
+            erased.clear();
+        }
+        dirty = false;
+    }
+    bool find(int key) {
+        if (dirty) rebuild();
+        return binarySearch(a, key) >= 0;
+    }
+    // Keys are never re-inserted after an erase in the stream, so the
+    // buffered inserts and erases never cancel out.
+    void insert(int key) {
+        a.push_back(key);
+        dirty = true;
+    }
+    void erase(int key) {
+        erased.push_back(key);
+        dirty = true;
+    }
+    vector<int> keys() {
+        if (dirty) rebuild();
+        return a;
+    }
+};
+
+/**
+ * @brief Applies ops[0, count) to s and returns the outcome.
+ */
+template <class Set>
+Outcome replay(Set& s, const vector<Op>& ops, size_t count) {
+    Outcome outcome;
+    for (size_t i = 0; i < count; ++i) {
+        const Op& op = ops[i];
+        if (op.kind == Op::Find) outcome.hits += s.find(op.key);
+        else if (op.kind == Op::Insert) s.insert(op.key);
+        else s.erase(op.key);
+    }
+    outcome.keys = s.keys();
+    return outcome;
+}
+
+Outcome replayReference(const vector<int>& initial, const vector<Op>& ops, size_t count) {
+    set<int> s(initial.begin(), initial.end());
+    Outcome outcome;
+    for (size_t i = 0; i < count; ++i) {
+        const Op& op = ops[i];
+        if (op.kind == Op::Find) outcome.hits += s.count(op.key);
+        else if (op.kind == Op::Insert) s.insert(op.key);
+        else s.erase(op.key);
+    }
+    outcome.keys.assign(s.begin(), s.end());
+    return outcome;
+}
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? stoull(argv[1]) : 1000000;
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 7;
+    cfg.maxTotalNs = 20e9;
+
+    // Distinct keys, shuffled: the first n start in the set, the rest
+    // are the keys inserted later.
+    DatasetSpec spec{Distribution::Uniform, 2 * n + 1000};
+    spec.maxValue = numeric_limits<int>::max();
+    vector<int> pool = loadDataset(spec);
+    sort(pool.begin(), pool.end());
+    pool.erase(unique(pool.begin(), pool.end()), pool.end());
+    mt19937_64 rng(kDefaultSeed);
+    shuffle(pool.begin(), pool.end(), rng);
+    if (pool.size() < n + 1) {
+        cerr << "Error: not enough distinct keys for n=" << n << endl;
+        return 1;
+    }
+    vector<int> initial(pool.begin(), pool.begin() + n);
+    vector<int> fresh(pool.begin() + n, pool.end());
+    sort(initial.begin(), initial.end());
+
+    const size_t max_ops = 1 << 18;
+    TreeSet tree;
+    SortedVectorSet sortedVector;
+    ReSortSet reSort;
+
+    tree.reset(initial);
+    cout << "--- Ordered set of " << n << " ints: B+ tree vs sorted array ---" << endl;
+    cout << "B+ tree: height " << tree.tree.height() << ", " << fixed << setprecision(1)
+         << tree.tree.memoryBytes() / 1048576.0 << " MiB (sorted array: " << n * sizeof(int) / 1048576.0
+         << " MiB)" << defaultfloat << endl;
+
+    for (double write_ratio : {0.0, 0.01, 0.1, 0.5}) {
+        // Operation stream: writes alternate insert (a fresh key) and
+        // erase (a present key, never one inserted by the stream).
+        vector<Op> ops(max_ops);
+        vector<int> erasable = initial;
+        shuffle(erasable.begin(), erasable.end(), rng);
+        size_t inserted = 0, erased = 0, writes = 0;
+        uniform_real_distribution<double> coin(0.0, 1.0);
+        for (Op& op : ops) {
+            bool write = coin(rng) < write_ratio && erased < erasable.size() && inserted < fresh.size();
+            if (!write) {
+                op = {Op::Find, rng() % 2 ? initial[rng() % n] : fresh[rng() % fresh.size()]};
+            } else if (writes++ % 2 == 0) {
+                op = {Op::Insert, fresh[inserted++]};
+            } else {
+                op = {Op::Erase, erasable[erased++]};
+            }
+        }
+
+        int percent = (int)lround(write_ratio * 100);
+        cout << "\n" << percent << "% writes:" << endl;
+
+        // Writes each structure may replay: a full array shift (or sort)
+        // per write caps the slow ones.
+        auto prefix = [&](size_t write_budget) {
+            return write_ratio == 0 ? max_ops : min(max_ops, (size_t)((double)write_budget / write_ratio));
+        };
+        auto run = [&](const string& name, auto& structure, size_t count) {
+            Outcome outcome;
+            bench::Stats stats = bench::measureWithSetup(
+                "OrderedSet_" + name + "_w" + to_string(percent), (long long)n,
+                [&] { structure.reset(initial); },
+                [&] { outcome = replay(structure, ops, count); }, cfg);
+            if (!(outcome == replayReference(initial, ops, count))) {
+                cerr << "Error: " << name << " disagrees with std::set at " << percent << "% writes" << endl;
+                return false;
+            }
+            cout << "  " << setw(30) << left << stats.algorithm << right << setw(8) << count << " ops"
+                 << fixed << setprecision(1) << setw(12) << stats.medianNs / (double)count << " ns/op"
+                 << defaultfloat << endl;
+            csv.write(stats);
+            return true;
+        };
+        if (!run("BPlusTree", tree, max_ops) || !run("SortedVector", sortedVector, prefix(2048)) ||
+            !run("ReSort", reSort, prefix(16)))
+            return 1;
+    }
+
+    // ---- range scans ----
+    cout << "\n--- Range scans (sum of the keys in [lo, lo + width)) ---" << endl;
+    tree.reset(initial);
+    const vector<int>& sorted = initial;
+    const int num_scans = 1024;
+    for (size_t keys_per_scan : {10, 100, 1000, 10000}) {
+        if (keys_per_scan > n) break;
+        // Width in key space that holds ~keys_per_scan keys on average.
+        int width = (int)min<double>(numeric_limits<int>::max(),
+                                     (double)numeric_limits<int>::max() / (double)n * (double)keys_per_scan);
+        vector<int> starts(num_scans);
+        for (int& lo : starts) lo = (int)(rng() % (uint64_t)(numeric_limits<int>::max() - width));
+
+        long long tree_sum = 0, array_sum = 0;
+        size_t si = 0;
+        vector<bench::Stats> results = {
+            bench::measure("RangeScan_BPlusTree_" + to_string(keys_per_scan), (long long)n, [&] {
+                int lo = starts[si++ % num_scans];
+                long long sum = 0;
+                tree.tree.scan(lo, lo + width, [&](int key, int) { sum += key; });
+                bench::doNotOptimize(sum);
+            }, cfg),
+            bench::measure("RangeScan_SortedVector_" + to_string(keys_per_scan), (long long)n, [&] {
+                int lo = starts[si++ % num_scans];
+                long long sum = 0;
+                for (size_t i = lower_bound(sorted.begin(), sorted.end(), lo) - sorted.begin();
+                     i < n && sorted[i] < lo + width; ++i)
+                    sum += sorted[i];
+                bench::doNotOptimize(sum);
+            }, cfg),
+        };
+
+        for (int lo : starts) {
+            tree.tree.scan(lo, lo + width, [&](int key, int) { tree_sum += key; });
+            for (auto it = lower_bound(sorted.begin(), sorted.end(), lo); it != sorted.end() && *it < lo + width; ++it)
+                array_sum += *it;
+        }
+        if (tree_sum != array_sum) {
+            cerr << "Error: range scans disagree for ~" << keys_per_scan << " keys" << endl;
+            return 1;
+        }
+
+        for (const bench::Stats& stats : results) {
+            cout << "  " << setw(30) << left << stats.algorithm << right;
+            bench::printStats(stats);
+            csv.write(stats);
+        }
+    }
+
+    cout << "\nResults appended to " << csv.path() << endl;
+    return 0;
+}
@@ -0,0 +1,506 @@
+// ===================================================================
+//                  B+ TREE (UPDATABLE ORDERED INDEX)
+// ===================================================================
+//
+// An ordered map from int keys to small values that stays searchable
+// while it is updated: insert, erase, point lookup, lower bound and
+// range scans are all O(log n), where a sorted vector needs an O(n)
+// shift or a full re-sort per update.
+//
+//   insert(key, value)  -> false if the key is already present
+//   erase(key)          -> false if the key is absent
+//   find(key)           -> pointer to the value, or nullptr
+//   lowerBound(key)     -> iterator at the first key >= key
+//   scan(lo, hi, f)     -> f(key, value) for every key in [lo, hi)
+//   assignSorted(...)   -> bulk load from sorted, distinct keys
+//
+// Key Notes:
+// - The keys of every node fill exactly one 64-byte cache line (16
+//   ints), and are searched with two AVX2 compares + popcount like the
+//   S-tree of searchLayouts.h (scalar without AVX2). Inner nodes have
+//   up to 17 children, so 10^9 keys are 8 levels deep.
+// - Leaves are linked left to right: a range scan descends once and
+//   then walks the leaves.
+// - Every node except the root holds at least 8 keys (also after
+//   erases, by borrowing from or merging with a sibling), so the tree
+//   is at least half full.
+// - Nodes come from two NodePools (nodePool.h): no malloc per node,
+//   and freed nodes are reused by later inserts.
+// - Values must be trivially copyable (ids, offsets, pointers, small
+//   structs); they are moved around with the keys.
+// - Build with -march=native (or -mavx2) to enable the AVX2 path.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "nodePool.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace bplustree_detail {
+
+constexpr int kNodeKeys = 16;  // one 64-byte cache line of ints
+
+/**
+ * @brief Number of nodes to split @p items entries into, evenly, so
+ *        that each gets about @p fill and never fewer than @p least or
+ *        more than @p most (a single node, the root, may have fewer).
+ */
+inline size_t nodesFor(size_t items, size_t fill, size_t least, size_t most) {
+    size_t fewest = (items + most - 1) / most;
+    size_t widest = std::max<size_t>(1, items / least);
+    return std::clamp((items + fill - 1) / fill, fewest, std::max(fewest, widest));
+}
+
+/**
+ * @brief Number of keys[0, count) that are < target (orEqual: <=).
+ */
+template <bool orEqual>
+inline int countBelow(const int* keys, int count, int target) {
+#ifdef __AVX2__
+    if (orEqual && target == INT_MAX) return count;  // every key is <= INT_MAX
+    // Lanes past count hold stale keys; the mask drops them.
+    __m256i x = _mm256_set1_epi32(target + orEqual);
+    __m256i a = _mm256_load_si256((const __m256i*)keys);
+    __m256i b = _mm256_load_si256((const __m256i*)(keys + 8));
+    unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, a))) |
+                    ((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, b))) << 8);
+    return __builtin_popcount(mask & ((1u << count) - 1));
+#else
+    int below = 0;
+    for (int i = 0; i < count; ++i) below += orEqual ? keys[i] <= target : keys[i] < target;
+    return below;
+#endif
+}
+
+}  // namespace bplustree_detail
+
+template <class Value>
+class BPlusTree {
+    static_assert(std::is_trivially_copyable_v<Value>, "BPlusTree values must be trivially copyable");
+    static constexpr int K = bplustree_detail::kNodeKeys;
+    static constexpr int kMinKeys = K / 2;
+
+    struct alignas(64) Leaf {
+        int keys[K];
+        Value values[K];
+        Leaf* next;
+        int count;
+    };
+
+    // keys[i] separates children[i] (keys < keys[i]) from children[i+1].
+    struct alignas(64) Inner {
+        int keys[K];
+        void* children[K + 1];
+        int count;  // keys; children = count + 1
+    };
+
+public:
+    /**
+     * @brief Position of one entry; end() is past the last one.
+     */
+    class Iterator {
+    public:
+        int key() const { return leaf_->keys[slot_]; }
+        const Value& value() const { return leaf_->values[slot_]; }
+
+        Iterator& operator++() {
+            if (++slot_ == leaf_->count) {
+                leaf_ = leaf_->next;
+                slot_ = 0;
+            }
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return leaf_ == other.leaf_ && slot_ == other.slot_; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class BPlusTree;
+        Iterator(const Leaf* leaf, int slot) : leaf_(leaf), slot_(slot) {}
+        const Leaf* leaf_;
+        int slot_;
+    };
+
+    BPlusTree() { clear(); }
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    size_t size() const { return size_; }
+    int height() const { return height_; }
+
+    /**
+     * @brief Bytes held by the node pools, including free slots.
+     */
+    size_t memoryBytes() const { return leaves_.capacityBytes() + inners_.capacityBytes(); }
+
+    /**
+     * @brief Removes every entry; node memory is kept for reuse.
+     */
+    void clear() {
+        leaves_.reset();
+        inners_.reset();
+        Leaf* leaf = leaves_.create();
+        leaf->next = nullptr;
+        leaf->count = 0;
+        root_ = leaf;
+        height_ = 1;
+        size_ = 0;
+    }
+
+    /**
+     * @brief Replaces the contents with n entries whose keys are sorted
+     *        and distinct; leaves are filled to @p fill keys (default
+     *        3/4) to leave room for later inserts.
+     */
+    void assignSorted(const int* keys, const Value* values, size_t n, int fill = K * 3 / 4) {
+        clear();
+        if (n == 0) return;
+        fill = std::clamp(fill, kMinKeys, K);
+
+        // Leaves: counts spread evenly, so none is far below fill and
+        // none below kMinKeys.
+        std::vector<void*> level;
+        std::vector<int> lowest;  // smallest key under each node of `level`
+        size_t leafCount = bplustree_detail::nodesFor(n, fill, kMinKeys, K);
+        leaves_.destroy(static_cast<Leaf*>(root_));
+        Leaf* prev = nullptr;
+        for (size_t l = 0, pos = 0; l < leafCount; ++l) {
+            size_t take = n / leafCount + (l < n % leafCount);
+            Leaf* leaf = leaves_.create();
+            std::copy(keys + pos, keys + pos + take, leaf->keys);
+            std::copy(values + pos, values + pos + take, leaf->values);
+            leaf->count = (int)take;
+            leaf->next = nullptr;
+            if (prev) prev->next = leaf;
+            prev = leaf;
+            level.push_back(leaf);
+            lowest.push_back(keys[pos]);
+            pos += take;
+        }
+
+        // Inner levels, bottom-up, with about fill + 1 children each.
+        height_ = 1;
+        while (level.size() > 1) {
+            size_t groups = bplustree_detail::nodesFor(level.size(), fill + 1, kMinKeys + 1, K + 1);
+            std::vector<void*> up;
+            std::vector<int> upLowest;
+            for (size_t g = 0, pos = 0; g < groups; ++g) {
+                size_t take = level.size() / groups + (g < level.size() % groups);
+                Inner* node = inners_.create();
+                node->count = (int)take - 1;
+                for (size_t c = 0; c < take; ++c) {
+                    node->children[c] = level[pos + c];
+                    if (c > 0) node->keys[c - 1] = lowest[pos + c];
+                }
+                up.push_back(node);
+                upLowest.push_back(lowest[pos]);
+                pos += take;
+            }
+            level.swap(up);
+            lowest.swap(upLowest);
+            ++height_;
+        }
+        root_ = level[0];
+        size_ = n;
+    }
+
+    /**
+     * @brief Pointer to the value stored under key, or nullptr.
+     */
+    const Value* find(int key) const {
+        const Leaf* leaf = findLeaf(key);
+        int pos = bplustree_detail::countBelow<false>(leaf->keys, leaf->count, key);
+        return pos < leaf->count && leaf->keys[pos] == key ? &leaf->values[pos] : nullptr;
+    }
+
+    bool contains(int key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief First entry with a key >= key, or end().
+     */
+    Iterator lowerBound(int key) const {
+        const Leaf* leaf = findLeaf(key);
+        int pos = bplustree_detail::countBelow<false>(leaf->keys, leaf->count, key);
+        if (pos == leaf->count) return Iterator(leaf->next, 0);
+        return Iterator(leaf, pos);
+    }
+
+    Iterator begin() const {
+        const void* node = root_;
+        for (int h = height_; h > 1; --h) node = static_cast<const Inner*>(node)->children[0];
+        const Leaf* leaf = static_cast<const Leaf*>(node);
+        return leaf->count ? Iterator(leaf, 0) : end();
+    }
+    Iterator end() const { return Iterator(nullptr, 0); }
+
+    /**
+     * @brief Calls f(key, value) for every key in [lo, hi), in order.
+     * @return The number of entries visited.
+     */
+    template <class F>
+    size_t scan(int lo, int hi, F&& f) const {
+        size_t visited = 0;
+        Iterator it = lowerBound(lo);
+        // Whole leaves at a time: one compare finds where hi falls in each.
+        for (const Leaf* leaf = it.leaf_; leaf; leaf = leaf->next) {
+            int first = leaf == it.leaf_ ? it.slot_ : 0;
+            int stop = bplustree_detail::countBelow<false>(leaf->keys, leaf->count, hi);
+            for (int i = first; i < stop; ++i) f(leaf->keys[i], leaf->values[i]);
+            visited += (size_t)std::max(0, stop - first);
+            if (stop < leaf->count) break;
+        }
+        return visited;
+    }
+
+    /**
+     * @brief Inserts (key, value) unless key is already present.
+     * @return true if inserted.
+     */
+    bool insert(int key, const Value& value) {
+        Path path;
+        Leaf* leaf = descend(key, path);
+        int pos = bplustree_detail::countBelow<false>(leaf->keys, leaf->count, key);
+        if (pos < leaf->count && leaf->keys[pos] == key) return false;
+        ++size_;
+
+        if (leaf->count < K) {
+            insertAt(leaf, pos, key, value);
+            return true;
+        }
+
+        // Split the full leaf in half, then insert into the right half.
+        Leaf* right = leaves_.create();
+        right->count = K - kMinKeys;
+        std::copy(leaf->keys + kMinKeys, leaf->keys + K, right->keys);
+        std::copy(leaf->values + kMinKeys, leaf->values + K, right->values);
+        leaf->count = kMinKeys;
+        right->next = leaf->next;
+        leaf->next = right;
+        if (pos <= kMinKeys) insertAt(leaf, pos, key, value);
+        else insertAt(right, pos - kMinKeys, key, value);
+
+        insertUp(path, right->keys[0], right);
+        return true;
+    }
+
+    /**
+     * @brief Removes key.
+     * @return true if it was present.
+     */
+    bool erase(int key) {
+        Path path;
+        Leaf* leaf = descend(key, path);
+        int pos = bplustree_detail::countBelow<false>(leaf->keys, leaf->count, key);
+        if (pos == leaf->count || leaf->keys[pos] != key) return false;
+        --size_;
+
+        std::copy(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+        std::copy(leaf->values + pos + 1, leaf->values + leaf->count, leaf->values + pos);
+        --leaf->count;
+        if (path.depth == 0 || leaf->count >= kMinKeys) return true;
+
+        rebalanceLeaf(path, leaf);
+        return true;
+    }
+
+private:
+    // Inner nodes from the root down to the leaf's parent, and which
+    // child was taken in each.
+    struct Path {
+        Inner* nodes[64];
+        int child[64];
+        int depth = 0;
+    };
+
+    const Leaf* findLeaf(int key) const {
+        const void* node = root_;
+        for (int h = height_; h > 1; --h) {
+            const Inner* inner = static_cast<const Inner*>(node);
+            node = inner->children[bplustree_detail::countBelow<true>(inner->keys, inner->count, key)];
+        }
+        return static_cast<const Leaf*>(node);
+    }
+
+    Leaf* descend(int key, Path& path) {
+        void* node = root_;
+        path.depth = 0;
+        for (int h = height_; h > 1; --h) {
+            Inner* inner = static_cast<Inner*>(node);
+            int c = bplustree_detail::countBelow<true>(inner->keys, inner->count, key);
+            path.nodes[path.depth] = inner;
+            path.child[path.depth++] = c;
+            node = inner->children[c];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    static void insertAt(Leaf* leaf, int pos, int key, const Value& value) {
+        std::copy_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::copy_backward(leaf->values + pos, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[pos] = key;
+        leaf->values[pos] = value;
+        ++leaf->count;
+    }
+
+    /**
+     * @brief Adds separator `key` with `right` as the child after it,
+     *        splitting full inner nodes on the way up.
+     */
+    void insertUp(Path& path, int key, void* right) {
+        while (path.depth > 0) {
+            Inner* node = path.nodes[--path.depth];
+            int c = path.child[path.depth];
+            if (node->count < K) {
+                std::copy_backward(node->keys + c, node->keys + node->count, node->keys + node->count + 1);
+                std::copy_backward(node->children + c + 1, node->children + node->count + 1,
+                                   node->children + node->count + 2);
+                node->keys[c] = key;
+                node->children[c + 1] = right;
+                ++node->count;
+                return;
+            }
+
+            // Full: lay out the K + 1 keys, push the middle one up.
+            int keys[K + 1];
+            void* children[K + 2];
+            std::copy(node->keys, node->keys + c, keys);
+            keys[c] = key;
+            std::copy(node->keys + c, node->keys + K, keys + c + 1);
+            std::copy(node->children, node->children + c + 1, children);
+            children[c + 1] = right;
+            std::copy(node->children + c + 1, node->children + K + 1, children + c + 2);
+
+            Inner* sibling = inners_.create();
+            node->count = kMinKeys;
+            std::copy(keys, keys + kMinKeys, node->keys);
+            std::copy(children, children + kMinKeys + 1, node->children);
+            sibling->count = K - kMinKeys;
+            std::copy(keys + kMinKeys + 1, keys + K + 1, sibling->keys);
+            std::copy(children + kMinKeys + 1, children + K + 2, sibling->children);
+
+            key = keys[kMinKeys];
+            right = sibling;
+        }
+
+        Inner* root = inners_.create();
+        root->count = 1;
+        root->keys[0] = key;
+        root->children[0] = root_;
+        root->children[1] = right;
+        root_ = root;
+        ++height_;
+    }
+
+    /**
+     * @brief Fixes a leaf below kMinKeys by borrowing from or merging
+     *        with a sibling under the same parent.
+     */
+    void rebalanceLeaf(Path& path, Leaf* leaf) {
+        Inner* parent = path.nodes[path.depth - 1];
+        int c = path.child[path.depth - 1];
+        Leaf* left = c > 0 ? static_cast<Leaf*>(parent->children[c - 1]) : nullptr;
+        Leaf* right = c < parent->count ? static_cast<Leaf*>(parent->children[c + 1]) : nullptr;
+
+        if (left && left->count > kMinKeys) {
+            --left->count;
+            insertAt(leaf, 0, left->keys[left->count], left->values[left->count]);
+            parent->keys[c - 1] = leaf->keys[0];
+            return;
+        }
+        if (right && right->count > kMinKeys) {
+            insertAt(leaf, leaf->count, right->keys[0], right->values[0]);
+            std::copy(right->keys + 1, right->keys + right->count, right->keys);
+            std::copy(right->values + 1, right->values + right->count, right->values);
+            --right->count;
+            parent->keys[c] = right->keys[0];
+            return;
+        }
+
+        // Merge into the left one of the pair and drop the right one.
+        if (!left) {
+            left = leaf;
+            leaf = right;
+            ++c;
+        }
+        std::copy(leaf->keys, leaf->keys + leaf->count, left->keys + left->count);
+        std::copy(leaf->values, leaf->values + leaf->count, left->values + left->count);
+        left->count += leaf->count;
+        left->next = leaf->next;
+        leaves_.destroy(leaf);
+        removeChild(path, c);
+    }
+
+    /**
+     * @brief Removes child c (and the separator before it) from the
+     *        deepest node of the path, rebalancing inner nodes upwards.
+     */
+    void removeChild(Path& path, int c) {
+        while (true) {
+            Inner* node = path.nodes[--path.depth];
+            std::copy(node->keys + c, node->keys + node->count, node->keys + c - 1);
+            std::copy(node->children + c + 1, node->children + node->count + 1, node->children + c);
+            --node->count;
+
+            if (path.depth == 0) {
+                if (node->count == 0) {  // the root has a single child left
+                    root_ = node->children[0];
+                    inners_.destroy(node);
+                    --height_;
+                }
+                return;
+            }
+            if (node->count >= kMinKeys) return;
+
+            Inner* parent = path.nodes[path.depth - 1];
+            int i = path.child[path.depth - 1];
+            Inner* left = i > 0 ? static_cast<Inner*>(parent->children[i - 1]) : nullptr;
+            Inner* right = i < parent->count ? static_cast<Inner*>(parent->children[i + 1]) : nullptr;
+
+            if (left && left->count > kMinKeys) {
+                // Rotate right: the separator comes down, left's last key goes up.
+                std::copy_backward(node->keys, node->keys + node->count, node->keys + node->count + 1);
+                std::copy_backward(node->children, node->children + node->count + 1,
+                                   node->children + node->count + 2);
+                node->keys[0] = parent->keys[i - 1];
+                node->children[0] = left->children[left->count];
+                ++node->count;
+                parent->keys[i - 1] = left->keys[--left->count];
+                return;
+            }
+            if (right && right->count > kMinKeys) {
+                // Rotate left: the separator comes down, right's first key goes up.
+                node->keys[node->count] = parent->keys[i];
+                node->children[node->count + 1] = right->children[0];
+                ++node->count;
+                parent->keys[i] = right->keys[0];
+                std::copy(right->keys + 1, right->keys + right->count, right->keys);
+                std::copy(right->children + 1, right->children + right->count + 1, right->children);
+                --right->count;
+                return;
+            }
+
+            // Merge with a sibling around their separator.
+            if (!left) {
+                left = node;
+                node = right;
+                ++i;
+            }
+            left->keys[left->count] = parent->keys[i - 1];
+            std::copy(node->keys, node->keys + node->count, left->keys + left->count + 1);
+            std::copy(node->children, node->children + node->count + 1, left->children + left->count + 1);
+            left->count += node->count + 1;
+            inners_.destroy(node);
+            c = i;
+        }
+    }
+
+    void* root_ = nullptr;
+    int height_ = 1;  // 1 = the root is a leaf
+    size_t size_ = 0;
+    NodePool<Leaf> leaves_;
+    NodePool<Inner> inners_;
+};
@@ -0,0 +1,179 @@
+// ===================================================================
+//                  BELLMAN-FORD SHORTEST PATH PROGRAM
+// ===================================================================
+//
+// C++ version of bellmanFord.py: reads the same graph.txt format
+// ("n m" header, directed "u v w" lines, negative weights allowed),
+// and either prints the shortest distances from the source or the
+// NEGATIVE CYCLE itself (bellmanFord.py only says whether one exists).
+//
+// Usage:
+//   ./bellmanFord                        graph.txt, from its first node
+//   ./bellmanFord FILE [SOURCE]          any graph.txt-style file
+//   ./bellmanFord --generate FILE N M    write a random N-node, M-edge
+//                                        graph with negative weights but
+//                                        no negative cycle
+//
+// Key Notes:
+// - Three engines run on the same edge array (see bellmanFord.h):
+//   sequential rounds with early exit, SPFA, and multi-threaded rounds.
+//   They must agree on the cycle / the distances.
+// - Each engine's reported cycle is checked to really be negative.
+// - The first run parses the text in parallel and saves FILE.csr; later
+//   runs map that snapshot directly (see graphLoader.h).
+// - Times are appended to benchmark_results.csv with the number of
+//   edges as InputSize.
+//
+// Build: g++ -O2 -pthread bellmanFord.cpp -o bellmanFord
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"    // Shared timing harness + CSV writer
+#include "bellmanFord.h"  // bellmanFord(), spfa(), bellmanFordParallel()
+#include "graphLoader.h"  // loadGraphCached(), CsrView
+using namespace std;
+
+/**
+ * @brief Writes a random graph.txt-style graph. Weights are
+ *        w + p(u) - p(v) for a random potential p and w >= 0, so many
+ *        are negative but every cycle sums to >= 0.
+ */
+bool writeRandomNegativeGraph(const string& path, size_t nodes, size_t edges, uint64_t seed) {
+    ofstream out(path);
+    if (!out) return false;
+    mt19937_64 gen(seed);
+    vector<long long> potential(nodes);
+    for (long long& p : potential) p = (long long)(gen() % 200);
+
+    out << nodes << " " << edges << "\n";
+    for (size_t i = 0; i < edges; ++i) {
+        // The first nodes-1 edges make every node reachable from v0.
+        size_t u = i + 1 < nodes ? gen() % (i + 1) : gen() % nodes;
+        size_t v = i + 1 < nodes ? i + 1 : gen() % nodes;
+        long long w = (long long)(gen() % 100) + potential[u] - potential[v];
+        out << 'v' << u << " v" << v << " " << w << "\n";
+    }
+    return (bool)out;
+}
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    if (argc == 5 && string(argv[1]) == "--generate") {
+        size_t nodes = stoull(argv[3]), edges = stoull(argv[4]);
+        if (nodes == 0 || !writeRandomNegativeGraph(argv[2], nodes, edges, 42)) {
+            cerr << "Error: could not write " << argv[2] << endl;
+            return 1;
+        }
+        cout << "Wrote " << edges << " edges over " << nodes << " nodes to " << argv[2] << endl;
+        return 0;
+    }
+
+    string file_name = argc > 1 ? argv[1] : "graph.txt";
+
+    // ---- load phase ----
+    size_t threads = max(1u, thread::hardware_concurrency());
+    ThreadPool pool(threads);
+
+    bench::threadCounters().start();
+    auto load_start = bench::Clock::now();
+    LoadedGraph loaded;
+    GraphLoadInfo load_info;
+    if (!loadGraphCached(file_name, EdgeListFormat::NodesEdgesThenEdges, loaded, &pool, &load_info)) return 1;
+    EdgeArray graph = edgeArrayOf(loaded.view());
+    double load_ns = bench::elapsedNs(load_start, bench::Clock::now());
+    bench::CounterValues load_counters = bench::threadCounters().stop();
+    const NameTable& names = loaded.view().names;
+
+    if (graph.nodes == 0) {
+        cerr << "Error: " << file_name << " has no nodes" << endl;
+        return 1;
+    }
+
+    string source_name = argc > 2 ? argv[2] : string(names.front());
+    long long source_id = loaded.view().idOf(source_name);
+    if (source_id < 0) {
+        cerr << "Error: unknown node " << source_name << endl;
+        return 1;
+    }
+    NodeId source = (NodeId)source_id;
+    cout << "Loaded " << file_name << ": " << graph.nodes << " nodes, " << graph.edges.size()
+         << " edges (" << threads << " threads for the parallel rounds)" << endl;
+
+    // ---- search phase ----
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 5;
+
+    long long m = (long long)graph.edges.size();
+    BellmanFordResult seq, queue_based, parallel;
+    vector<bench::Stats> results;
+    results.push_back(bench::measure("BellmanFord", m, [&] { seq = bellmanFord(graph, source); }, cfg));
+    results.push_back(bench::measure("BellmanFord_SPFA", m, [&] { queue_based = spfa(graph, source); }, cfg));
+    results.push_back(bench::measure("BellmanFord_t" + to_string(threads), m,
+                                     [&] { parallel = bellmanFordParallel(graph, source, pool); }, cfg));
+
+    // ---- verification ----
+    const BellmanFordResult* all[] = {&seq, &queue_based, &parallel};
+    for (const BellmanFordResult* r : all) {
+        if (r->hasNegativeCycle() != seq.hasNegativeCycle()) {
+            cerr << "Error: engines disagree on whether there is a negative cycle" << endl;
+            return 1;
+        }
+        if (r->hasNegativeCycle()) {
+            Distance w = cycleWeight(graph, r->negativeCycle);
+            if (w == kInfinity || w >= 0) {
+                cerr << "Error: reported cycle is not a negative cycle" << endl;
+                return 1;
+            }
+        } else if (r->dist != seq.dist) {
+            cerr << "Error: engines disagree on the distances" << endl;
+            return 1;
+        }
+    }
+
+    // ---- output ----
+    if (seq.hasNegativeCycle()) {
+        cout << file_name << " contains a negative cycle (reachable from " << source_name << "):\n  ";
+        for (NodeId v : seq.negativeCycle) cout << names[v] << " -> ";
+        cout << names[seq.negativeCycle.front()]
+             << "  (total weight " << cycleWeight(graph, seq.negativeCycle) << ")" << endl;
+    } else {
+        cout << file_name << " doesn't contain a negative cycle reachable from " << source_name << endl;
+        if (graph.nodes <= 30) {
+            cout << "\nDistances from " << source_name << ":" << endl;
+            for (size_t v = 0; v < graph.nodes; ++v) {
+                cout << "  " << setw(6) << left << names[v] << right;
+                if (seq.dist[v] == kInfinity) cout << "unreachable" << endl;
+                else cout << seq.dist[v] << endl;
+            }
+        } else {
+            size_t reachable = count_if(seq.dist.begin(), seq.dist.end(),
+                                        [](Distance d) { return d != kInfinity; });
+            cout << reachable << " of " << graph.nodes << " nodes reachable from " << source_name << endl;
+        }
+    }
+
+    cout << fixed << setprecision(3)
+         << "\nLoad phase:   " << load_ns / 1e6 << " ms ("
+         << (load_info.fromSnapshot ? "mapped " + load_info.snapshotPath
+                                    : "parallel parse + intern names + write snapshot")
+         << " + edge array)"
+         << "\nSequential:   " << results[0].medianNs / 1e6 << " ms, " << seq.rounds << " rounds"
+         << "\nSPFA:         " << results[1].medianNs / 1e6 << " ms, " << queue_based.rounds << " queue pops"
+         << "\nParallel:     " << results[2].medianNs / 1e6 << " ms, " << parallel.rounds << " rounds"
+         << defaultfloat << endl;
+
+    bench::ResultWriter csv;
+    if (csv.isOpen()) {
+        csv.write(bench::fromSamples(load_info.fromSnapshot ? "BellmanFord_load_snapshot" : "BellmanFord_load",
+                                     m, {load_ns}, load_counters));
+        for (const bench::Stats& s : results) csv.write(s);
+        cout << "Results appended to " << csv.path() << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,285 @@
+// ===================================================================
+//                 BELLMAN-FORD / SPFA SHORTEST PATHS
+// ===================================================================
+//
+// Single-source shortest paths with NEGATIVE weights allowed, and
+// extraction of a negative cycle when one is reachable.
+//
+// Key Notes:
+// - EdgeArray keeps all edges in one flat array of {from, to, weight}
+//   sorted by source, so a round is one sequential scan and dist[from]
+//   reads are mostly cache hits.
+// - bellmanFord() relaxes in place (newer values are used within the
+//   same round) and stops early as soon as a round changes nothing;
+//   a change in round n proves a negative cycle.
+// - spfa() only re-examines nodes whose distance changed (a FIFO work
+//   queue). A negative cycle shows up as a shortest path with >= n
+//   edges, tracked per node.
+// - bellmanFordParallel() runs Jacobi-style rounds: every thread owns
+//   a range of TARGET nodes and reads the previous round's distances
+//   over incoming edges, so no atomics are needed.
+// - In all modes a detected cycle is returned as an actual node list
+//   (from the parent pointers), not just a yes/no.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "dijkstra.h"  // Distance, kInfinity, kNoNode
+#include "graph.h"
+#include "threadPool.h"
+
+/**
+ * @brief Flat edge list sorted by source, plus an in-edge CSR for the
+ *        parallel rounds.
+ */
+struct EdgeArray {
+    size_t nodes = 0;
+    std::vector<Edge> edges;  // sorted by from
+
+    // Incoming edges of v: inFrom/inWeight[inOffsets[v] .. inOffsets[v+1])
+    std::vector<uint64_t> inOffsets;
+    std::vector<NodeId> inFrom;
+    std::vector<EdgeWeight> inWeight;
+
+    EdgeArray() = default;
+    EdgeArray(std::vector<Edge> list, size_t nodeCount) : nodes(nodeCount), edges(std::move(list)) {
+        auto bySource = [](const Edge& a, const Edge& b) { return a.from < b.from; };
+        if (!std::is_sorted(edges.begin(), edges.end(), bySource))
+            std::stable_sort(edges.begin(), edges.end(), bySource);
+
+        inOffsets.assign(nodes + 1, 0);
+        for (const Edge& e : edges) inOffsets[e.to + 1]++;
+        for (size_t v = 0; v < nodes; ++v) inOffsets[v + 1] += inOffsets[v];
+        inFrom.resize(edges.size());
+        inWeight.resize(edges.size());
+        std::vector<uint64_t> fill(inOffsets.begin(), inOffsets.end() - 1);
+        for (const Edge& e : edges) {
+            uint64_t pos = fill[e.to]++;
+            inFrom[pos] = e.from;
+            inWeight[pos] = e.weight;
+        }
+    }
+};
+
+/**
+ * @brief Edge array of a CsrGraph or CsrView (CSR order is already
+ *        sorted by source, so no sort is needed).
+ */
+template <class Graph>
+EdgeArray edgeArrayOf(const Graph& graph) {
+    std::vector<Edge> edges;
+    edges.reserve(graph.arcCount());
+    for (size_t u = 0; u < graph.nodeCount(); ++u)
+        for (uint64_t e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e)
+            edges.push_back({(NodeId)u, graph.targets[e], graph.weights[e]});
+    return EdgeArray(std::move(edges), graph.nodeCount());
+}
+
+/**
+ * @brief Result of a Bellman-Ford style search.
+ */
+struct BellmanFordResult {
+    std::vector<Distance> dist;           // meaningful when cycle is empty
+    std::vector<NodeId> parent;
+    std::vector<NodeId> negativeCycle;    // nodes in cycle order, empty if none
+    size_t rounds = 0;                    // rounds (or queue pops for SPFA)
+    bool hasNegativeCycle() const { return !negativeCycle.empty(); }
+};
+
+namespace bellman_detail {
+
+/**
+ * @brief Walks the parent chain from @p start. If a node repeats, the
+ *        repeated part is a cycle and is returned in forward order.
+ */
+inline std::vector<NodeId> cycleFrom(const std::vector<NodeId>& parent, NodeId start) {
+    size_t n = parent.size();
+    std::vector<char> seen(n, 0);
+    NodeId v = start;
+    while (v != kNoNode && !seen[v]) {
+        seen[v] = 1;
+        v = parent[v];
+    }
+    if (v == kNoNode) return {};
+
+    std::vector<NodeId> cycle;
+    NodeId u = v;
+    do {
+        cycle.push_back(u);
+        u = parent[u];
+    } while (u != v);
+    std::reverse(cycle.begin(), cycle.end());  // parent links point backwards
+    return cycle;
+}
+
+/**
+ * @brief Any cycle of the parent graph (every such cycle is negative).
+ */
+inline std::vector<NodeId> anyParentCycle(const std::vector<NodeId>& parent) {
+    size_t n = parent.size();
+    // 0 = unvisited, 1 = on the current walk, 2 = done
+    std::vector<char> state(n, 0);
+    for (size_t s = 0; s < n; ++s) {
+        NodeId v = (NodeId)s;
+        while (v != kNoNode && state[v] == 0) {
+            state[v] = 1;
+            v = parent[v];
+        }
+        if (v != kNoNode && state[v] == 1) return cycleFrom(parent, v);
+        for (NodeId u = (NodeId)s; u != kNoNode && state[u] == 1; u = parent[u]) state[u] = 2;
+    }
+    return {};
+}
+
+}  // namespace bellman_detail
+
+/**
+ * @brief Sequential Bellman-Ford with early termination.
+ */
+inline BellmanFordResult bellmanFord(const EdgeArray& g, NodeId source) {
+    BellmanFordResult r;
+    r.dist.assign(g.nodes, kInfinity);
+    r.parent.assign(g.nodes, kNoNode);
+    r.dist[source] = 0;
+
+    NodeId lastRelaxed = kNoNode;
+    for (size_t round = 1; round <= g.nodes; ++round) {
+        lastRelaxed = kNoNode;
+        for (const Edge& e : g.edges) {
+            Distance du = r.dist[e.from];
+            if (du == kInfinity) continue;
+            if (du + e.weight < r.dist[e.to]) {
+                r.dist[e.to] = du + e.weight;
+                r.parent[e.to] = e.from;
+                lastRelaxed = e.to;
+            }
+        }
+        r.rounds = round;
+        if (lastRelaxed == kNoNode) return r;  // converged early
+    }
+
+    // Still relaxing in round n: walking back n parents lands on the cycle.
+    NodeId v = lastRelaxed;
+    for (size_t i = 0; i < g.nodes && r.parent[v] != kNoNode; ++i) v = r.parent[v];
+    r.negativeCycle = bellman_detail::cycleFrom(r.parent, v);
+    if (r.negativeCycle.empty()) r.negativeCycle = bellman_detail::anyParentCycle(r.parent);
+    return r;
+}
+
+/**
+ * @brief SPFA (queue-based Bellman-Ford) with cycle detection by the
+ *        number of edges on each node's current shortest path.
+ */
+inline BellmanFordResult spfa(const EdgeArray& g, NodeId source) {
+    BellmanFordResult r;
+    size_t n = g.nodes;
+    r.dist.assign(n, kInfinity);
+    r.parent.assign(n, kNoNode);
+    r.dist[source] = 0;
+
+    // Out-edge ranges: edges are sorted by source.
+    std::vector<uint64_t> begin(n + 1, 0);
+    for (const Edge& e : g.edges) begin[e.from + 1]++;
+    for (size_t v = 0; v < n; ++v) begin[v + 1] += begin[v];
+
+    std::vector<uint32_t> pathEdges(n, 0);
+    std::vector<char> inQueue(n, 0);
+    std::deque<NodeId> queue{source};
+    inQueue[source] = 1;
+
+    while (!queue.empty()) {
+        NodeId u = queue.front();
+        queue.pop_front();
+        inQueue[u] = 0;
+        ++r.rounds;
+
+        for (uint64_t i = begin[u]; i < begin[u + 1]; ++i) {
+            const Edge& e = g.edges[i];
+            Distance nd = r.dist[u] + e.weight;
+            if (nd < r.dist[e.to]) {
+                r.dist[e.to] = nd;
+                r.parent[e.to] = u;
+                pathEdges[e.to] = pathEdges[u] + 1;
+                if (pathEdges[e.to] >= n) {
+                    // A simple path has < n edges: this one repeats a node.
+                    r.negativeCycle = bellman_detail::cycleFrom(r.parent, e.to);
+                    if (r.negativeCycle.empty()) r.negativeCycle = bellman_detail::anyParentCycle(r.parent);
+                    return r;
+                }
+                if (!inQueue[e.to]) {
+                    inQueue[e.to] = 1;
+                    queue.push_back(e.to);
+                }
+            }
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief Multi-threaded Bellman-Ford: Jacobi rounds, threads split the
+ *        target nodes and pull over incoming edges.
+ */
+inline BellmanFordResult bellmanFordParallel(const EdgeArray& g, NodeId source, ThreadPool& pool) {
+    BellmanFordResult r;
+    size_t n = g.nodes;
+    r.dist.assign(n, kInfinity);
+    r.parent.assign(n, kNoNode);
+    r.dist[source] = 0;
+    std::vector<Distance> next = r.dist;
+
+    // Several chunks per thread so stealing can even out skewed in-degrees.
+    const size_t grain = std::max<size_t>(1024, n / (pool.size() * 8) + 1);
+
+    for (size_t round = 1; round <= n; ++round) {
+        std::atomic<bool> changed{false};
+        pool.parallelFor(0, n, grain, [&](size_t lo, size_t hi) {
+            bool local = false;
+            for (size_t v = lo; v < hi; ++v) {
+                Distance best = r.dist[v];
+                NodeId bestParent = r.parent[v];
+                for (uint64_t i = g.inOffsets[v]; i < g.inOffsets[v + 1]; ++i) {
+                    Distance du = r.dist[g.inFrom[i]];
+                    if (du != kInfinity && du + g.inWeight[i] < best) {
+                        best = du + g.inWeight[i];
+                        bestParent = g.inFrom[i];
+                    }
+                }
+                next[v] = best;
+                if (best < r.dist[v]) {
+                    r.parent[v] = bestParent;  // only this thread touches v
+                    local = true;
+                }
+            }
+            if (local) changed.store(true, std::memory_order_relaxed);
+        });
+        std::swap(r.dist, next);
+        r.rounds = round;
+        if (!changed.load()) return r;
+    }
+
+    // Still changing after n rounds: a negative cycle exists. Any cycle
+    // in the parent graph is negative; fall back to the sequential
+    // version if the parent graph has not closed one yet.
+    r.negativeCycle = bellman_detail::anyParentCycle(r.parent);
+    if (r.negativeCycle.empty()) r.negativeCycle = bellmanFord(g, source).negativeCycle;
+    return r;
+}
+
+/**
+ * @brief Sum of the weights around a cycle (for verification).
+ */
+inline Distance cycleWeight(const EdgeArray& g, const std::vector<NodeId>& cycle) {
+    Distance total = 0;
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        NodeId u = cycle[i], v = cycle[(i + 1) % cycle.size()];
+        Distance best = kInfinity;
+        for (const Edge& e : g.edges)
+            if (e.from == u && e.to == v) best = std::min<Distance>(best, e.weight);
+        if (best == kInfinity) return kInfinity;
+        total += best;
+    }
+    return total;
+}
@@ -0,0 +1,226 @@
+// ===================================================================
+//                BENCHMARK BASELINE & REGRESSION CHECK
+// ===================================================================
+//
+// Saves the latest benchmark results as a named baseline and checks
+// later runs against it, per (algorithm, input size), with a
+// Mann-Whitney U test on the raw per-call samples (see benchStore.h).
+//
+// Usage:
+//   ./benchCompare runs                  list the stored runs
+//   ./benchCompare save NAME [--run ID]  save the latest result of every
+//                                        (algorithm, size) as baseline
+//   ./benchCompare compare NAME [--run ID] [--alpha A] [--threshold PCT]
+//                              [--filter TEXT]
+//
+// Key Notes:
+// - "Latest" means the last stored row per (algorithm, size), i.e.
+//   the newest run that measured it; --run restricts to one run.
+// - A result is a REGRESSION when the samples are significantly slower
+//   (one-sided p < alpha, default 0.01) AND the median slowed down by
+//   more than the threshold (default 10%): significant but tiny shifts
+//   and large but noisy ones are both ignored.
+// - Samples of one run share its machine state, so run-to-run drift on
+//   a busy or virtualised machine can look significant; raise
+//   --threshold there, or compare on a quiet machine.
+// - Results with fewer than 3 samples on either side (one-shot phases
+//   such as graph loading) are shown but never fail the check.
+// - Baselines are stored in benchmark_baselines/NAME.csv together with
+//   the environment of the runs they came from; a comparison warns
+//   when the CPU, compiler or flags differ.
+// - Exit code: 0 = no regression, 1 = regression, 2 = usage / IO error.
+//
+// Build: g++ -O2 benchCompare.cpp -o benchCompare
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchStore.h"  // RunInfo, SampleSet, mannWhitneyGreater()
+using namespace std;
+
+const string kRunsFile = "benchmark_runs.csv";
+const string kSamplesFile = "benchmark_samples.csv";
+const string kBaselineDir = "benchmark_baselines";
+const string kBaselineHeader = string(bench::RunInfo::kHeader) + ",Algorithm,InputSize,Batch,Samples_ns";
+const size_t kMinSamples = 3;
+
+using Key = pair<string, long long>;  // (algorithm, input size)
+
+struct Entry {
+    bench::RunInfo run;
+    bench::SampleSet samples;
+};
+
+double median(vector<double> v) {
+    sort(v.begin(), v.end());
+    size_t n = v.size();
+    return n == 0 ? 0.0 : n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2.0;
+}
+
+/**
+ * @brief The latest stored result per (algorithm, size), joined with
+ *        the metadata of its run.
+ */
+bool loadLatest(const string& runId, map<Key, Entry>& latest) {
+    vector<map<string, string>> runRows, sampleRows;
+    if (!bench::readCsv(kRunsFile, bench::RunInfo::kHeader, runRows) ||
+        !bench::readCsv(kSamplesFile, bench::SampleSet::kHeader, sampleRows)) {
+        cerr << "Error: no results stored here (" << kRunsFile << ", " << kSamplesFile << ")" << endl;
+        return false;
+    }
+    map<string, bench::RunInfo> runs;
+    for (const auto& row : runRows) {
+        bench::RunInfo r = bench::RunInfo::fromRow(row);
+        runs[r.runId] = r;
+    }
+    for (const auto& row : sampleRows) {
+        bench::SampleSet s = bench::SampleSet::fromRow(row);
+        if (!runId.empty() && s.runId != runId) continue;
+        auto run = runs.find(s.runId);
+        if (run == runs.end()) continue;
+        latest[{s.algorithm, s.inputSize}] = {run->second, s};
+    }
+    if (latest.empty()) {
+        cerr << "Error: no stored results" << (runId.empty() ? "" : " for run " + runId) << endl;
+        return false;
+    }
+    return true;
+}
+
+bool loadBaseline(const string& name, map<Key, Entry>& baseline) {
+    string path = kBaselineDir + "/" + name + ".csv";
+    vector<map<string, string>> rows;
+    if (!bench::readCsv(path, kBaselineHeader, rows)) {
+        cerr << "Error: baseline " << path << " not found" << endl;
+        return false;
+    }
+    for (const auto& row : rows) {
+        Entry e{bench::RunInfo::fromRow(row), bench::SampleSet::fromRow(row)};
+        baseline[{e.samples.algorithm, e.samples.inputSize}] = e;
+    }
+    return true;
+}
+
+int listRuns() {
+    vector<map<string, string>> rows;
+    if (!bench::readCsv(kRunsFile, bench::RunInfo::kHeader, rows)) {
+        cerr << "Error: " << kRunsFile << " not found" << endl;
+        return 2;
+    }
+    for (const auto& row : rows) {
+        bench::RunInfo r = bench::RunInfo::fromRow(row);
+        cout << left << setw(26) << r.runId << setw(22) << r.timestamp << setw(20) << r.program << setw(20) << r.commit
+             << r.compiler << " [" << r.flags << "] " << r.cpu << endl;
+    }
+    return 0;
+}
+
+int saveBaseline(const string& name, const string& runId) {
+    map<Key, Entry> latest;
+    if (!loadLatest(runId, latest)) return 2;
+
+    filesystem::create_directories(kBaselineDir);
+    string path = kBaselineDir + "/" + name + ".csv";
+    ofstream out(path, ios::trunc);
+    out << kBaselineHeader << "\n";
+    for (const auto& [key, e] : latest) {
+        // SampleSet rows start with the RunId, which the run row already has.
+        string sampleRow = e.samples.csvRow();
+        out << e.run.csvRow() << sampleRow.substr(sampleRow.find(',')) << "\n";
+    }
+    if (!out) {
+        cerr << "Error: could not write " << path << endl;
+        return 2;
+    }
+    cout << "Saved " << latest.size() << " results as baseline '" << name << "' (" << path << ")" << endl;
+    return 0;
+}
+
+int compare(const string& name, const string& runId, double alpha, double threshold, const string& filter) {
+    map<Key, Entry> baseline, latest;
+    if (!loadBaseline(name, baseline) || !loadLatest(runId, latest)) return 2;
+
+    // ---- environment differences ----
+    set<string> warnings;
+    for (const auto& [key, current] : latest) {
+        auto base = baseline.find(key);
+        if (base == baseline.end()) continue;
+        const bench::RunInfo &a = base->second.run, &b = current.run;
+        if (a.cpu != b.cpu) warnings.insert("CPU: " + a.cpu + " -> " + b.cpu);
+        if (a.compiler != b.compiler) warnings.insert("compiler: " + a.compiler + " -> " + b.compiler);
+        if (a.flags != b.flags) warnings.insert("flags: " + a.flags + " -> " + b.flags);
+    }
+    for (const string& w : warnings) cout << "Warning: environment differs, " << w << endl;
+
+    cout << left << setw(44) << "Algorithm" << right << setw(12) << "n" << setw(14) << "Base ns" << setw(14)
+         << "New ns" << setw(10) << "Change" << setw(10) << "p" << "  Verdict" << endl;
+
+    size_t compared = 0, regressions = 0;
+    for (const auto& [key, current] : latest) {
+        if (!filter.empty() && key.first.find(filter) == string::npos) continue;
+        auto base = baseline.find(key);
+        if (base == baseline.end()) continue;
+        ++compared;
+
+        const vector<double>& a = base->second.samples.sampleNs;
+        const vector<double>& b = current.samples.sampleNs;
+        double baseMedian = median(a), newMedian = median(b);
+        double change = baseMedian > 0 ? newMedian / baseMedian - 1.0 : 0.0;
+
+        string verdict, p = "-";
+        if (a.size() < kMinSamples || b.size() < kMinSamples) {
+            verdict = "too few samples";
+        } else {
+            double slower = bench::mannWhitneyGreater(a, b);
+            double faster = bench::mannWhitneyGreater(b, a);
+            ostringstream ps;
+            ps << setprecision(2) << (change >= 0 ? slower : faster);
+            p = ps.str();
+            if (slower < alpha && change > threshold) {
+                verdict = "REGRESSION";
+                ++regressions;
+            } else if (faster < alpha && change < -threshold) {
+                verdict = "faster";
+            } else {
+                verdict = "same";
+            }
+        }
+        cout << left << setw(44) << key.first << right << setw(12) << key.second << fixed << setprecision(1)
+             << setw(14) << baseMedian << setw(14) << newMedian << setw(9)
+             << change * 100 << "%" << setw(10) << p << "  " << verdict << defaultfloat << endl;
+    }
+
+    cout << "\n" << compared << " results compared against baseline '" << name << "', " << regressions
+         << " regression(s) (alpha=" << setprecision(6) << alpha << ", threshold=" << threshold * 100 << "%)" << endl;
+    return regressions > 0 ? 1 : 0;
+}
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    vector<string> args(argv + 1, argv + argc);
+    string command = args.empty() ? "" : args[0];
+    string name, runId, filter;
+    double alpha = 0.01, threshold = 0.10;
+
+    for (size_t i = 1; i < args.size(); ++i) {
+        bool hasValue = i + 1 < args.size();
+        if (args[i] == "--run" && hasValue) runId = args[++i];
+        else if (args[i] == "--alpha" && hasValue) alpha = stod(args[++i]);
+        else if (args[i] == "--threshold" && hasValue) threshold = stod(args[++i]) / 100.0;
+        else if (args[i] == "--filter" && hasValue) filter = args[++i];
+        else if (name.empty()) name = args[i];
+        else command.clear();  // unexpected argument
+    }
+
+    if (command == "runs") return listRuns();
+    if (command == "save" && !name.empty()) return saveBaseline(name, runId);
+    if (command == "compare" && !name.empty()) return compare(name, runId, alpha, threshold, filter);
+
+    cerr << "Usage: " << argv[0] << " runs\n"
+         << "       " << argv[0] << " save NAME [--run ID]\n"
+         << "       " << argv[0] << " compare NAME [--run ID] [--alpha A] [--threshold PCT] [--filter TEXT]" << endl;
+    return 2;
+}
@@ -0,0 +1,382 @@
+// ===================================================================
+//                 BENCHMARK RESULT STORE & COMPARISON
+// ===================================================================
+//
+// What bench::ResultWriter records besides the summary rows of
+// benchmark_results.csv, and what benchCompare.cpp reads back.
+//
+// Files (next to benchmark_results.csv):
+//   benchmark_runs.csv     one row per program run: RunId, timestamp,
+//                          program, git commit, compiler, flags, CPU,
+//                          host, hardware threads
+//   benchmark_samples.csv  one row per result: RunId, algorithm, input
+//                          size, batch and EVERY per-call sample
+//                          (';'-separated), so runs can be compared
+//                          sample by sample, not only by their median
+//
+// Key Notes:
+// - A run is registered on its first written result, so programs that
+//   fail before measuring anything leave no trace.
+// - The commit comes from `git rev-parse` in the working directory
+//   ("+dirty" with uncommitted changes) unless BENCH_COMMIT is set.
+// - Compiler flags cannot be read back at run time: define
+//   BENCH_FLAGS (-DBENCH_FLAGS='"-O2 -march=native"') to record them,
+//   otherwise the flags column summarises what the predefined macros
+//   reveal (optimisation on/off, SIMD level, NDEBUG, sanitizers).
+// - mannWhitneyGreater() is the one-sided Mann-Whitney U test used to
+//   decide whether a new run is really slower than its baseline: exact
+//   for small samples without ties, normal approximation with tie and
+//   continuity correction otherwise. It assumes nothing about the
+//   shape of the timing distribution.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include <unistd.h>
+
+namespace bench {
+
+// ===================================================================
+//                            CSV HELPERS
+// ===================================================================
+
+/**
+ * @brief Quotes a CSV field if it contains a comma, quote or newline.
+ */
+inline std::string csvField(const std::string& s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) return s;
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+/**
+ * @brief Splits one CSV line into fields (RFC 4180 quoting).
+ */
+inline std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') fields.back() += line[++i];
+            else if (c == '"') quoted = false;
+            else fields.back() += c;
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+/**
+ * @brief Appends @p row to the CSV at @p path, writing @p header first
+ *        if the file is new. A file with another header is moved aside
+ *        to "<path>.legacy". Returns false if it cannot be written.
+ */
+inline bool appendCsvRow(const std::string& path, const std::string& header, const std::string& row) {
+    std::string firstLine;
+    {
+        std::ifstream in(path);
+        if (in) std::getline(in, firstLine);
+    }
+    if (!firstLine.empty() && firstLine != header) {
+        std::rename(path.c_str(), (path + ".legacy").c_str());
+        std::cerr << "Note: " << path << " had an old format; moved to " << path << ".legacy" << std::endl;
+        firstLine.clear();
+    }
+    std::ofstream out(path, std::ios::app);
+    if (!out) return false;
+    if (firstLine.empty()) out << header << "\n";
+    out << row << "\n";
+    return (bool)out;
+}
+
+/**
+ * @brief Reads a CSV written by appendCsvRow(): one map per row, keyed
+ *        by the header's column names. False if missing or mismatched.
+ */
+inline bool readCsv(const std::string& path, const std::string& header,
+                    std::vector<std::map<std::string, std::string>>& rows) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != header) return false;
+    std::vector<std::string> columns = splitCsvLine(header);
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> fields = splitCsvLine(line);
+        if (fields.size() != columns.size()) continue;  // torn write: skip
+        std::map<std::string, std::string> row;
+        for (size_t i = 0; i < columns.size(); ++i) row[columns[i]] = fields[i];
+        rows.push_back(std::move(row));
+    }
+    return true;
+}
+
+// ===================================================================
+//                          RUN METADATA
+// ===================================================================
+
+struct RunInfo {
+    std::string runId, timestamp, program, commit, compiler, flags, cpu, host;
+    unsigned threads = 0;
+
+    static constexpr const char* kHeader = "RunId,Timestamp,Program,Commit,Compiler,Flags,CPU,Host,Threads";
+
+    std::string csvRow() const {
+        return csvField(runId) + "," + csvField(timestamp) + "," + csvField(program) + "," + csvField(commit) + "," +
+               csvField(compiler) + "," + csvField(flags) + "," + csvField(cpu) + "," + csvField(host) + "," +
+               std::to_string(threads);
+    }
+
+    static RunInfo fromRow(const std::map<std::string, std::string>& row) {
+        RunInfo r;
+        r.runId = row.at("RunId");
+        r.timestamp = row.at("Timestamp");
+        r.program = row.at("Program");
+        r.commit = row.at("Commit");
+        r.compiler = row.at("Compiler");
+        r.flags = row.at("Flags");
+        r.cpu = row.at("CPU");
+        r.host = row.at("Host");
+        r.threads = (unsigned)std::strtoul(row.at("Threads").c_str(), nullptr, 10);
+        return r;
+    }
+};
+
+namespace store_detail {
+
+/**
+ * @brief First line of a shell command's output, or "" on failure.
+ */
+inline std::string commandLine(const char* command) {
+    std::string out;
+    if (FILE* p = ::popen(command, "r")) {
+        char buffer[256];
+        if (std::fgets(buffer, sizeof(buffer), p)) out = buffer;
+        ::pclose(p);
+    }
+    while (!out.empty() && (out.back() == '\n' || out.back() == '\r')) out.pop_back();
+    return out;
+}
+
+inline std::string gitCommit() {
+    if (const char* env = std::getenv("BENCH_COMMIT")) return env;
+    std::string commit = commandLine("git rev-parse --short=12 HEAD 2>/dev/null");
+    if (commit.empty()) return "unknown";
+    if (!commandLine("git status --porcelain --untracked-files=no 2>/dev/null").empty()) commit += "+dirty";
+    return commit;
+}
+
+inline std::string compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+inline std::string compileFlags() {
+#if defined(BENCH_FLAGS)
+    return BENCH_FLAGS;
+#else
+    std::string f;
+#if defined(__OPTIMIZE__)
+    f += "optimized";
+#else
+    f += "-O0";
+#endif
+#if defined(__AVX512F__)
+    f += " avx512f";
+#elif defined(__AVX2__)
+    f += " avx2";
+#elif defined(__SSE4_2__)
+    f += " sse4.2";
+#endif
+#if defined(NDEBUG)
+    f += " NDEBUG";
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+    f += " asan";
+#endif
+#if defined(__SANITIZE_THREAD__)
+    f += " tsan";
+#endif
+    return f;
+#endif
+}
+
+inline std::string cpuModel() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+    }
+    return "unknown";
+}
+
+inline std::string programName() {
+#if defined(__GLIBC__)
+    return program_invocation_short_name;
+#else
+    return "unknown";
+#endif
+}
+
+}  // namespace store_detail
+
+/**
+ * @brief Describes the current process: time, commit, toolchain, machine.
+ */
+inline RunInfo captureRunInfo() {
+    using namespace store_detail;
+    RunInfo r;
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+    ::gmtime_r(&now, &utc);
+    char stamp[32], id[32];
+    std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    std::strftime(id, sizeof(id), "%Y%m%dT%H%M%S", &utc);
+    r.timestamp = stamp;
+    r.runId = std::string(id) + "-" + std::to_string(::getpid());
+    r.program = programName();
+    r.commit = gitCommit();
+    r.compiler = compilerName();
+    r.flags = compileFlags();
+    r.cpu = cpuModel();
+    char host[256] = {};
+    r.host = ::gethostname(host, sizeof(host) - 1) == 0 ? host : "unknown";
+    r.threads = std::max(1u, std::thread::hardware_concurrency());
+    return r;
+}
+
+// ===================================================================
+//                         PER-SAMPLE ROWS
+// ===================================================================
+
+/**
+ * @brief All samples of one result, as stored in benchmark_samples.csv.
+ */
+struct SampleSet {
+    std::string runId, algorithm;
+    long long inputSize = 0, batch = 1;
+    std::vector<double> sampleNs;
+
+    static constexpr const char* kHeader = "RunId,Algorithm,InputSize,Batch,Samples_ns";
+
+    std::string csvRow() const {
+        std::ostringstream samples;
+        samples << std::fixed << std::setprecision(2);
+        for (size_t i = 0; i < sampleNs.size(); ++i) samples << (i ? ";" : "") << sampleNs[i];
+        return csvField(runId) + "," + csvField(algorithm) + "," + std::to_string(inputSize) + "," +
+               std::to_string(batch) + "," + samples.str();
+    }
+
+    static SampleSet fromRow(const std::map<std::string, std::string>& row) {
+        SampleSet s;
+        s.runId = row.at("RunId");
+        s.algorithm = row.at("Algorithm");
+        s.inputSize = std::strtoll(row.at("InputSize").c_str(), nullptr, 10);
+        s.batch = std::strtoll(row.at("Batch").c_str(), nullptr, 10);
+        std::istringstream in(row.at("Samples_ns"));
+        std::string value;
+        while (std::getline(in, value, ';'))
+            if (!value.empty()) s.sampleNs.push_back(std::strtod(value.c_str(), nullptr));
+        return s;
+    }
+};
+
+/**
+ * @brief Path of a store file next to the results CSV at @p resultsPath.
+ */
+inline std::string storePath(const std::string& resultsPath, const std::string& file) {
+    std::filesystem::path dir = std::filesystem::path(resultsPath).parent_path();
+    return (dir / file).string();
+}
+
+// ===================================================================
+//                        MANN-WHITNEY U TEST
+// ===================================================================
+
+/**
+ * @brief One-sided Mann-Whitney U test.
+ *
+ * @return p-value of H1 "values in @p b tend to be LARGER than in @p a"
+ *         (1.0 if either side is empty).
+ */
+inline double mannWhitneyGreater(const std::vector<double>& a, const std::vector<double>& b) {
+    size_t n1 = a.size(), n2 = b.size();
+    if (n1 == 0 || n2 == 0) return 1.0;
+
+    // Midranks of the pooled samples.
+    std::vector<std::pair<double, int>> pooled;
+    for (double x : a) pooled.push_back({x, 0});
+    for (double x : b) pooled.push_back({x, 1});
+    std::sort(pooled.begin(), pooled.end());
+    size_t n = pooled.size();
+    double rankSumB = 0, tieTerm = 0;
+    bool ties = false;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && pooled[j].first == pooled[i].first) ++j;
+        double t = (double)(j - i), midrank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; ++k)
+            if (pooled[k].second == 1) rankSumB += midrank;
+        tieTerm += t * t * t - t;
+        ties = ties || t > 1;
+        i = j;
+    }
+    // U counts pairs (x in a, y in b) with y > x.
+    double u = rankSumB - n2 * (n2 + 1) / 2.0;
+
+    if (!ties && n <= 60) {
+        // Exact null distribution: ways[k] = arrangements with U == k,
+        // by the recurrence over the largest pooled element.
+        size_t maxU = n1 * n2;
+        std::vector<std::vector<double>> prev(n2 + 1, std::vector<double>(maxU + 1, 0.0)), cur = prev;
+        for (size_t j = 0; j <= n2; ++j) prev[j][0] = 1.0;  // i = 0: U is always 0
+        for (size_t i = 1; i <= n1; ++i) {
+            for (size_t j = 0; j <= n2; ++j) {
+                std::fill(cur[j].begin(), cur[j].end(), 0.0);
+                for (size_t k = 0; k <= i * j; ++k) {
+                    // Largest element from b adds i to U; from a adds nothing.
+                    double ways = prev[j][k];
+                    if (j > 0 && k >= i) ways += cur[j - 1][k - i];
+                    cur[j][k] = ways;
+                }
+            }
+            std::swap(prev, cur);
+        }
+        const std::vector<double>& ways = prev[n2];
+        double total = 0, tail = 0;
+        for (size_t k = 0; k <= maxU; ++k) {
+            total += ways[k];
+            if ((double)k >= u - 1e-9) tail += ways[k];
+        }
+        return tail / total;
+    }
+
+    double mean = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1) - tieTerm / ((double)n * (n - 1)));
+    if (variance <= 0) return 1.0;
+    double z = (u - mean - 0.5) / std::sqrt(variance);  // continuity correction
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+}  // namespace bench
@@ -0,0 +1,351 @@
+// ===================================================================
+//                    SHARED BENCHMARK HARNESS
+// ===================================================================
+//
+// Header-only timing harness used by every benchmark program in this
+// repository. Include it, build a bench::Config, and call one of the
+// measure functions; the returned bench::Stats can be printed and
+// appended to benchmark_results.csv through bench::ResultWriter.
+//
+// Key Notes:
+// - Warmup samples are run first and thrown away (cold caches, page
+//   faults and frequency ramp-up are not part of the result).
+// - Kernels that finish in well under a microsecond are repeated in a
+//   batch until a single timed sample is long enough that clock
+//   overhead no longer dominates; the reported times are per call.
+// - doNotOptimize() / clobberMemory() stop the compiler from deleting
+//   a kernel whose result is never used.
+// - Every sample is kept, so min / median / mean / p99 / stddev are
+//   all reported instead of a single average.
+// - All programs write ONE schema to benchmark_results.csv, with the
+//   header written only when the file is new. Every row carries the
+//   RunId of its program run; the run's environment (commit, compiler,
+//   flags, CPU, ...) and every raw sample are stored alongside (see
+//   benchStore.h) for benchCompare.cpp.
+// - Hardware counters (cycles, IPC, cache / branch misses, page faults;
+//   see perfCounters.h) are read around every timed sample and written
+//   as extra columns; columns the machine cannot count stay empty.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "benchStore.h"
+#include "perfCounters.h"
+
+namespace bench {
+
+// ===================================================================
+//                     OPTIMIZATION BARRIERS
+// ===================================================================
+
+/**
+ * @brief Forces the compiler to materialise a value, so a kernel whose
+ *        result is otherwise unused cannot be optimized away.
+ */
+template <class T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Forces all pending memory writes to be treated as observable.
+ */
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+// ===================================================================
+//                     CONFIGURATION & RESULTS
+// ===================================================================
+
+/**
+ * @brief Knobs for a single measurement.
+ */
+struct Config {
+    int warmupSamples = 3;         // untimed samples run before measuring
+    int samples = 30;              // timed samples to collect
+    double minSampleNs = 10000.0;  // batch fast kernels up to at least this
+    long long maxBatch = 1 << 24;  // upper bound on calls per sample
+    double maxTotalNs = 5e9;       // stop collecting samples past this budget
+};
+
+/**
+ * @brief Summary statistics of one (algorithm, input size) measurement.
+ *        All times are nanoseconds per single kernel call.
+ */
+struct Stats {
+    std::string algorithm;
+    long long inputSize = 0;
+    int samples = 0;
+    long long batch = 1;  // kernel calls per timed sample
+    double minNs = 0, medianNs = 0, meanNs = 0, p99Ns = 0, stddevNs = 0;
+    std::vector<double> sampleNs;  // raw per-call time of every sample
+    CounterValues counters;        // mean per call over the timed samples
+};
+
+// ===================================================================
+//                        INTERNAL HELPERS
+// ===================================================================
+
+using Clock = std::chrono::steady_clock;
+
+inline double elapsedNs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/**
+ * @brief Nearest-rank percentile of an already sorted sample vector.
+ */
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+    if (rank == 0) rank = 1;
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+/**
+ * @brief Fills in the summary fields of @p stats from its raw samples.
+ */
+inline void summarize(Stats& stats) {
+    std::vector<double> sorted = stats.sampleNs;
+    std::sort(sorted.begin(), sorted.end());
+    stats.samples = (int)sorted.size();
+    if (sorted.empty()) return;
+
+    double sum = 0;
+    for (double s : sorted) sum += s;
+    stats.meanNs = sum / sorted.size();
+
+    double var = 0;
+    for (double s : sorted) var += (s - stats.meanNs) * (s - stats.meanNs);
+    stats.stddevNs = sorted.size() > 1 ? std::sqrt(var / (sorted.size() - 1)) : 0.0;
+
+    stats.minNs = sorted.front();
+    stats.medianNs = sorted.size() % 2
+                         ? sorted[sorted.size() / 2]
+                         : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+    stats.p99Ns = percentile(sorted, 99.0);
+}
+
+// ===================================================================
+//                        MEASUREMENT API
+// ===================================================================
+
+/**
+ * @brief Measures a kernel that can be called repeatedly on the same
+ *        state (searches, Fibonacci, ...).
+ *
+ * The batch size is calibrated once by doubling until one batch takes
+ * at least cfg.minSampleNs, then every sample times a whole batch.
+ *
+ * @param algorithm Name written to the "Algorithm" column.
+ * @param inputSize Value written to the "InputSize" column.
+ * @param kernel    Callable taking no arguments.
+ */
+template <class Kernel>
+Stats measure(const std::string& algorithm, long long inputSize, Kernel&& kernel,
+              const Config& cfg = Config()) {
+    Stats stats;
+    stats.algorithm = algorithm;
+    stats.inputSize = inputSize;
+
+    auto runBatch = [&](long long batch) {
+        auto start = Clock::now();
+        for (long long i = 0; i < batch; ++i) {
+            kernel();
+            clobberMemory();
+        }
+        return elapsedNs(start, Clock::now());
+    };
+    PerfCounters& counters = threadCounters();
+    long long countedCalls = 0;
+
+    // Calibration doubles as the first warmup sample.
+    long long batch = 1;
+    double t = runBatch(batch);
+    while (t < cfg.minSampleNs && batch < cfg.maxBatch) {
+        batch *= 2;
+        t = runBatch(batch);
+    }
+    stats.batch = batch;
+
+    double spent = t;
+    for (int i = 1; i < cfg.warmupSamples && spent < cfg.maxTotalNs; ++i)
+        spent += runBatch(batch);
+
+    for (int i = 0; i < cfg.samples; ++i) {
+        if (i > 0 && spent >= cfg.maxTotalNs) break;
+        counters.start();
+        double ns = runBatch(batch);
+        stats.counters += counters.stop();
+        countedCalls += batch;
+        spent += ns;
+        stats.sampleNs.push_back(ns / batch);
+    }
+
+    stats.counters = stats.counters.perCall((double)countedCalls);
+    summarize(stats);
+    return stats;
+}
+
+/**
+ * @brief Measures a kernel that consumes its input (sorting), so a
+ *        fresh input has to be prepared before every single call.
+ *
+ * @p setup runs outside the timed region before each call; the kernel
+ * is therefore never batched.
+ */
+template <class Setup, class Kernel>
+Stats measureWithSetup(const std::string& algorithm, long long inputSize, Setup&& setup,
+                       Kernel&& kernel, const Config& cfg = Config()) {
+    Stats stats;
+    stats.algorithm = algorithm;
+    stats.inputSize = inputSize;
+    stats.batch = 1;
+
+    double spent = 0;
+    for (int i = 0; i < cfg.warmupSamples && spent < cfg.maxTotalNs; ++i) {
+        setup();
+        auto start = Clock::now();
+        kernel();
+        clobberMemory();
+        spent += elapsedNs(start, Clock::now());
+    }
+
+    PerfCounters& counters = threadCounters();
+    for (int i = 0; i < cfg.samples; ++i) {
+        if (i > 0 && spent >= cfg.maxTotalNs) break;
+        setup();
+        clobberMemory();
+        counters.start();
+        auto start = Clock::now();
+        kernel();
+        clobberMemory();
+        double ns = elapsedNs(start, Clock::now());
+        stats.counters += counters.stop();
+        spent += ns;
+        stats.sampleNs.push_back(ns);
+    }
+
+    stats.counters = stats.counters.perCall((double)stats.sampleNs.size());
+    summarize(stats);
+    return stats;
+}
+
+/**
+ * @brief Builds Stats from samples timed elsewhere (one-shot phases
+ *        such as loading a file, which are too slow to repeat).
+ *        @p counters are per call, e.g. from threadCounters().stop().
+ */
+inline Stats fromSamples(const std::string& algorithm, long long inputSize,
+                         std::vector<double> sampleNs, const CounterValues& counters = CounterValues()) {
+    Stats stats;
+    stats.algorithm = algorithm;
+    stats.inputSize = inputSize;
+    stats.sampleNs = std::move(sampleNs);
+    stats.counters = counters;
+    summarize(stats);
+    return stats;
+}
+
+// ===================================================================
+//                           REPORTING
+// ===================================================================
+
+/**
+ * @brief Prints one result line to stdout.
+ */
+inline void printStats(const Stats& s) {
+    std::cout << std::fixed << std::setprecision(1)
+              << "n=" << s.inputSize
+              << " | min=" << s.minNs << " ns"
+              << " | median=" << s.medianNs << " ns"
+              << " | p99=" << s.p99Ns << " ns"
+              << " | stddev=" << s.stddevNs << " ns"
+              << " (" << s.samples << " samples x " << s.batch << " calls)"
+              << std::defaultfloat << std::endl;
+    if (!s.counters.any()) return;
+
+    // Per call: IPC only with both cycles and instructions.
+    std::cout << "    " << std::fixed << std::setprecision(2);
+    if (s.counters.has(Counter::Cycles) && s.counters.has(Counter::Instructions))
+        std::cout << "IPC=" << s.counters.ipc() << " ";
+    for (size_t i = 0; i < kCounterCount; ++i)
+        if (s.counters.valid[i])
+            std::cout << counterName((Counter)i) << "=" << s.counters.value[i] << " ";
+    std::cout << "(per call)" << std::defaultfloat << std::endl;
+}
+
+/**
+ * @brief Appends results to the shared CSV file.
+ *
+ * The header is written only when the file is new. A file left behind
+ * by an older program with a different header is moved aside to
+ * "<path>.legacy" instead of being mixed with the current schema.
+ * The first write() also registers the run in benchmark_runs.csv; each
+ * write() stores the raw samples in benchmark_samples.csv.
+ */
+class ResultWriter {
+public:
+    static constexpr const char* kHeader =
+        "RunId,Algorithm,InputSize,Samples,Batch,Min_ns,Median_ns,Mean_ns,P99_ns,Stddev_ns,"
+        "Cycles,Instructions,IPC,L1D_misses,LLC_misses,Branch_misses,Page_faults";
+
+    explicit ResultWriter(const std::string& path = "benchmark_results.csv")
+        : path_(path),
+          runsPath_(storePath(path, "benchmark_runs.csv")),
+          samplesPath_(storePath(path, "benchmark_samples.csv")),
+          run_(captureRunInfo()) {
+        std::string firstLine;
+        {
+            std::ifstream in(path_);
+            if (in) std::getline(in, firstLine);
+        }
+        if (!firstLine.empty() && firstLine != kHeader) {
+            std::rename(path_.c_str(), (path_ + ".legacy").c_str());
+            std::cerr << "Note: " << path_ << " had an old format; moved to "
+                      << path_ << ".legacy" << std::endl;
+            firstLine.clear();
+        }
+        out_.open(path_, std::ios::app);
+        if (out_ && firstLine.empty()) out_ << kHeader << "\n";
+    }
+
+    bool isOpen() const { return out_.is_open(); }
+    const std::string& path() const { return path_; }
+    const RunInfo& run() const { return run_; }
+
+    void write(const Stats& s) {
+        if (!registered_) registered_ = appendCsvRow(runsPath_, RunInfo::kHeader, run_.csvRow());
+        appendCsvRow(samplesPath_, SampleSet::kHeader,
+                     SampleSet{run_.runId, s.algorithm, s.inputSize, s.batch, s.sampleNs}.csvRow());
+
+        out_ << run_.runId << "," << csvField(s.algorithm) << "," << s.inputSize << "," << s.samples << "," << s.batch
+             << std::fixed << std::setprecision(2)
+             << "," << s.minNs << "," << s.medianNs << "," << s.meanNs
+             << "," << s.p99Ns << "," << s.stddevNs;
+        // Counter columns: per call, empty when not counted.
+        auto column = [&](Counter c) {
+            out_ << ",";
+            if (s.counters.has(c)) out_ << s.counters[c];
+        };
+        column(Counter::Cycles);
+        column(Counter::Instructions);
+        out_ << ",";
+        if (s.counters.has(Counter::Cycles) && s.counters.has(Counter::Instructions)) out_ << s.counters.ipc();
+        for (Counter c : {Counter::L1DMisses, Counter::LLCMisses, Counter::BranchMisses, Counter::PageFaults})
+            column(c);
+        out_ << std::defaultfloat << "\n";
+        out_.flush();
+    }
+
+private:
+    std::string path_, runsPath_, samplesPath_;
+    RunInfo run_;
+    bool registered_ = false;
+    std::ofstream out_;
+};
+
+}  // namespace bench
@@ -0,0 +1,362 @@
+// ===================================================================
+//                   ARBITRARY-PRECISION UNSIGNED INTEGER
+// ===================================================================
+//
+// A minimal non-negative big integer, just big enough for exact
+// Fibonacci numbers with millions of digits.
+//
+// Key Notes:
+// - The value is a little-endian vector of 64-bit limbs with no
+//   leading zero limbs (zero is the empty vector).
+// - Multiplication is schoolbook below kKaratsubaThreshold limbs and
+//   Karatsuba above it (3 half-size products instead of 4, so
+//   O(n^1.585) instead of O(n^2)). Squaring has its own, cheaper, path
+//   for both.
+// - Very unbalanced products are cut into balanced pieces first, so
+//   Karatsuba always splits operands of similar length.
+// - Subtraction requires a >= b; there are no negative values.
+// - toString() is the simple O(n^2) conversion; it is meant for
+//   printing small values. lowDigits() gives the last decimal digits
+//   of any value in O(n).
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+
+class BigUnsigned {
+public:
+    using Limb = uint64_t;
+    using Wide = unsigned __int128;
+
+    // Below this many limbs schoolbook multiplication is faster.
+    static constexpr size_t kKaratsubaThreshold = 40;
+
+    BigUnsigned() = default;
+    BigUnsigned(Limb value) {
+        if (value) limbs_.push_back(value);
+    }
+
+    bool isZero() const { return limbs_.empty(); }
+    size_t limbCount() const { return limbs_.size(); }
+    const std::vector<Limb>& limbs() const { return limbs_; }
+
+    size_t bitLength() const {
+        if (limbs_.empty()) return 0;
+        return 64 * (limbs_.size() - 1) + (64 - __builtin_clzll(limbs_.back()));
+    }
+
+    // ---------------------------------------------------------------
+    //                        ARITHMETIC
+    // ---------------------------------------------------------------
+
+    friend BigUnsigned operator+(const BigUnsigned& a, const BigUnsigned& b) {
+        const BigUnsigned& big = a.limbs_.size() >= b.limbs_.size() ? a : b;
+        const BigUnsigned& small = a.limbs_.size() >= b.limbs_.size() ? b : a;
+        BigUnsigned r = big;
+        r.limbs_.push_back(0);
+        addInto(r.limbs_.data(), r.limbs_.size(), small.limbs_.data(), small.limbs_.size());
+        r.trim();
+        return r;
+    }
+
+    /**
+     * @brief a - b; requires a >= b.
+     */
+    friend BigUnsigned operator-(const BigUnsigned& a, const BigUnsigned& b) {
+        assert(compare(a, b) >= 0);
+        BigUnsigned r = a;
+        subFrom(r.limbs_.data(), r.limbs_.size(), b.limbs_.data(), b.limbs_.size());
+        r.trim();
+        return r;
+    }
+
+    friend BigUnsigned operator*(const BigUnsigned& a, const BigUnsigned& b) {
+        BigUnsigned r;
+        if (a.isZero() || b.isZero()) return r;
+        r.limbs_.assign(a.limbs_.size() + b.limbs_.size(), 0);
+        multiply(a.limbs_.data(), a.limbs_.size(), b.limbs_.data(), b.limbs_.size(), r.limbs_.data());
+        r.trim();
+        return r;
+    }
+
+    BigUnsigned square() const {
+        BigUnsigned r;
+        if (isZero()) return r;
+        r.limbs_.assign(2 * limbs_.size(), 0);
+        squareInto(limbs_.data(), limbs_.size(), r.limbs_.data());
+        r.trim();
+        return r;
+    }
+
+    /**
+     * @brief Shift left by fewer than 64 bits.
+     */
+    BigUnsigned operator<<(unsigned bits) const {
+        assert(bits < 64);
+        if (bits == 0 || isZero()) return *this;
+        BigUnsigned r;
+        r.limbs_.resize(limbs_.size() + 1);
+        Limb carry = 0;
+        for (size_t i = 0; i < limbs_.size(); ++i) {
+            r.limbs_[i] = (limbs_[i] << bits) | carry;
+            carry = limbs_[i] >> (64 - bits);
+        }
+        r.limbs_.back() = carry;
+        r.trim();
+        return r;
+    }
+
+    BigUnsigned& addSmall(Limb v) {
+        limbs_.push_back(0);
+        Limb small[1] = {v};
+        addInto(limbs_.data(), limbs_.size(), small, 1);
+        trim();
+        return *this;
+    }
+
+    /**
+     * @brief this -= v; requires this >= v.
+     */
+    BigUnsigned& subSmall(Limb v) {
+        Limb small[1] = {v};
+        subFrom(limbs_.data(), limbs_.size(), small, v ? 1 : 0);
+        trim();
+        return *this;
+    }
+
+    friend int compare(const BigUnsigned& a, const BigUnsigned& b) {
+        if (a.limbs_.size() != b.limbs_.size()) return a.limbs_.size() < b.limbs_.size() ? -1 : 1;
+        for (size_t i = a.limbs_.size(); i-- > 0;)
+            if (a.limbs_[i] != b.limbs_[i]) return a.limbs_[i] < b.limbs_[i] ? -1 : 1;
+        return 0;
+    }
+
+    friend bool operator==(const BigUnsigned& a, const BigUnsigned& b) { return a.limbs_ == b.limbs_; }
+    friend bool operator!=(const BigUnsigned& a, const BigUnsigned& b) { return a.limbs_ != b.limbs_; }
+
+    // ---------------------------------------------------------------
+    //                         CONVERSION
+    // ---------------------------------------------------------------
+
+    /**
+     * @brief this mod m, for m > 0, in one pass over the limbs.
+     */
+    Limb modSmall(Limb m) const {
+        Wide rem = 0;
+        for (size_t i = limbs_.size(); i-- > 0;) rem = ((rem << 64) | limbs_[i]) % m;
+        return (Limb)rem;
+    }
+
+    /**
+     * @brief The last (up to 19) decimal digits, without leading zeros.
+     */
+    std::string lowDigits(int count = 19) const {
+        Limb p = 1;
+        for (int i = 0; i < count && i < 19; ++i) p *= 10;
+        return std::to_string(modSmall(p));
+    }
+
+    /**
+     * @brief Full decimal representation (O(n^2), for small values).
+     */
+    std::string toString() const {
+        if (isZero()) return "0";
+        const Limb chunk = 10000000000000000000ull;  // 10^19
+        std::vector<Limb> cur = limbs_;
+        std::vector<Limb> parts;
+        while (!cur.empty()) {
+            Wide rem = 0;
+            for (size_t i = cur.size(); i-- > 0;) {
+                Wide v = (rem << 64) | cur[i];
+                cur[i] = (Limb)(v / chunk);
+                rem = v % chunk;
+            }
+            parts.push_back((Limb)rem);
+            while (!cur.empty() && cur.back() == 0) cur.pop_back();
+        }
+        std::string s = std::to_string(parts.back());
+        for (size_t i = parts.size() - 1; i-- > 0;) {
+            std::string p = std::to_string(parts[i]);
+            s += std::string(19 - p.size(), '0') + p;
+        }
+        return s;
+    }
+
+private:
+    std::vector<Limb> limbs_;
+
+    void trim() {
+        while (!limbs_.empty() && limbs_.back() == 0) limbs_.pop_back();
+    }
+
+    // ---------------------------------------------------------------
+    //                    RAW LIMB-ARRAY KERNELS
+    // ---------------------------------------------------------------
+
+    /**
+     * @brief r[0,rn) += a[0,an); the final carry must fit in r.
+     */
+    static void addInto(Limb* r, size_t rn, const Limb* a, size_t an) {
+        Limb carry = 0;
+        size_t i = 0;
+        for (; i < an; ++i) {
+            Wide s = (Wide)r[i] + a[i] + carry;
+            r[i] = (Limb)s;
+            carry = (Limb)(s >> 64);
+        }
+        for (; carry && i < rn; ++i) carry = (++r[i] == 0);
+    }
+
+    /**
+     * @brief r[0,rn) -= a[0,an); requires r >= a.
+     */
+    static void subFrom(Limb* r, size_t rn, const Limb* a, size_t an) {
+        Limb borrow = 0;
+        size_t i = 0;
+        for (; i < an; ++i) {
+            Limb x = r[i], y = a[i];
+            Limb d = x - y - borrow;
+            borrow = (x < y) || (x - y < borrow);
+            r[i] = d;
+        }
+        for (; borrow && i < rn; ++i) borrow = (r[i]-- == 0);
+    }
+
+    /**
+     * @brief out[0,na+nb) = a * b, schoolbook. out must not alias.
+     */
+    static void mulSchool(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* out) {
+        std::fill(out, out + na + nb, 0);
+        for (size_t i = 0; i < na; ++i) {
+            Limb carry = 0;
+            Wide ai = a[i];
+            for (size_t j = 0; j < nb; ++j) {
+                Wide t = ai * b[j] + out[i + j] + carry;
+                out[i + j] = (Limb)t;
+                carry = (Limb)(t >> 64);
+            }
+            out[i + nb] = carry;
+        }
+    }
+
+    /**
+     * @brief out[0,2n) = a^2, schoolbook: each cross product once, then
+     *        doubled, then the squares on the diagonal added.
+     */
+    static void sqrSchool(const Limb* a, size_t n, Limb* out) {
+        std::fill(out, out + 2 * n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            Limb carry = 0;
+            Wide ai = a[i];
+            for (size_t j = i + 1; j < n; ++j) {
+                Wide t = ai * a[j] + out[i + j] + carry;
+                out[i + j] = (Limb)t;
+                carry = (Limb)(t >> 64);
+            }
+            out[i + n] = carry;
+        }
+        // double the cross products
+        Limb top = 0;
+        for (size_t i = 0; i < 2 * n; ++i) {
+            Limb next = out[i] >> 63;
+            out[i] = (out[i] << 1) | top;
+            top = next;
+        }
+        // add the diagonal a[i]^2
+        Limb carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            Wide sq = (Wide)a[i] * a[i];
+            Wide lo = (Wide)out[2 * i] + (Limb)sq + carry;
+            out[2 * i] = (Limb)lo;
+            Wide hi = (Wide)out[2 * i + 1] + (Limb)(sq >> 64) + (Limb)(lo >> 64);
+            out[2 * i + 1] = (Limb)hi;
+            carry = (Limb)(hi >> 64);
+        }
+    }
+
+    /**
+     * @brief s[0,m+1) = x[0,nx) + y[0,ny), with nx, ny <= m.
+     */
+    static void addPadded(const Limb* x, size_t nx, const Limb* y, size_t ny, Limb* s, size_t m) {
+        std::fill(s, s + m + 1, 0);
+        std::copy(x, x + nx, s);
+        addInto(s, m + 1, y, ny);
+    }
+
+    /**
+     * @brief out[0,na+nb) = a * b. out must not alias a or b.
+     */
+    static void multiply(const Limb* a, size_t na, const Limb* b, size_t nb, Limb* out) {
+        if (na < nb) {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        if (nb < kKaratsubaThreshold) {
+            mulSchool(a, na, b, nb, out);
+            return;
+        }
+
+        if (na >= 2 * nb) {
+            // Unbalanced: multiply b by nb-sized slices of a.
+            std::fill(out, out + na + nb, 0);
+            std::vector<Limb> part(2 * nb);
+            for (size_t off = 0; off < na; off += nb) {
+                size_t len = std::min(nb, na - off);
+                multiply(a + off, len, b, nb, part.data());
+                addInto(out + off, na + nb - off, part.data(), len + nb);
+            }
+            return;
+        }
+
+        // Karatsuba: a = a1*B^m + a0, b = b1*B^m + b0 (nb > m since na < 2nb).
+        size_t m = na / 2;
+        const Limb *a0 = a, *a1 = a + m, *b0 = b, *b1 = b + m;
+        size_t na1 = na - m, nb1 = nb - m;
+
+        // z0 -> out[0,2m), z2 -> out[2m, na+nb)
+        multiply(a0, m, b0, m, out);
+        multiply(a1, na1, b1, nb1, out + 2 * m);
+
+        // z1 = (a0+a1)(b0+b1) - z0 - z2
+        size_t h = std::max(m, na1);
+        std::vector<Limb> sa(h + 1), sb(h + 1), z1(2 * h + 2);
+        addPadded(a0, m, a1, na1, sa.data(), h);
+        addPadded(b0, m, b1, nb1, sb.data(), h);
+        multiply(sa.data(), h + 1, sb.data(), h + 1, z1.data());
+        subFrom(z1.data(), z1.size(), out, 2 * m);
+        subFrom(z1.data(), z1.size(), out + 2 * m, na1 + nb1);
+
+        size_t z1len = z1.size();
+        while (z1len > 0 && z1[z1len - 1] == 0) --z1len;
+        addInto(out + m, na + nb - m, z1.data(), z1len);
+    }
+
+    /**
+     * @brief out[0,2n) = a^2. out must not alias a.
+     */
+    static void squareInto(const Limb* a, size_t n, Limb* out) {
+        if (n < kKaratsubaThreshold) {
+            sqrSchool(a, n, out);
+            return;
+        }
+
+        size_t m = n / 2, n1 = n - m;
+        const Limb *a0 = a, *a1 = a + m;
+
+        squareInto(a0, m, out);
+        squareInto(a1, n1, out + 2 * m);
+
+        // z1 = (a0+a1)^2 - z0 - z2 = 2*a0*a1
+        std::vector<Limb> s(n1 + 1), z1(2 * n1 + 2);
+        addPadded(a0, m, a1, n1, s.data(), n1);
+        squareInto(s.data(), n1 + 1, z1.data());
+        subFrom(z1.data(), z1.size(), out, 2 * m);
+        subFrom(z1.data(), z1.size(), out + 2 * m, 2 * n1);
+
+        size_t z1len = z1.size();
+        while (z1len > 0 && z1[z1len - 1] == 0) --z1len;
+        addInto(out + m, 2 * n - m, z1.data(), z1len);
+    }
+};
@@ -3,7 +3,7 @@
 // ===================================================================
 //
 // This program benchmarks the performance of Binary Search on arrays
-// of different input sizes. Results are averaged over multiple runs
+// of different input sizes. Results are measured over multiple runs
 // for stability, and saved into a single CSV file that can contain
 // multiple algorithms for easy comparison.
 //
@@ -13,98 +13,170 @@
 // - The target is chosen as -1, which is guaranteed NOT to exist
 //   in the generated array, ensuring worst-case performance.
 // - Results are saved with an "Algorithm" column for plotting legends.
+// - A second section compares binarySearch() with the static
+//   Eytzinger and S-tree layouts on random lookups for n = 10^3 up to
+//   10^7 (or up to the n passed as first argument, e.g. 1000000000),
+//   which reaches the memory-bound regime. Build time and memory of
+//   each layout are printed too.
+// - A third section answers whole batches of lookups with
+//   binarySearchBatch() and compares queries per second against a
+//   loop of single binarySearch() calls.
+//
+// Build: g++ -O2 -march=native binarySearch.cpp -o binarySearch
 //
 // ===================================================================
 
 #include <bits/stdc++.h>
-#include <fstream>   // For file I/O
+#include "benchmark.h"  // Shared timing harness + CSV writer
+#include "binarySearch.h"  // binarySearch(), binarySearchBatch()
+#include "datasetGenerator.h"  // loadDataset(): seeded, cached inputs
+#include "searchLayouts.h"  // EytzingerIndex, STreeIndex
 using namespace std;
 using namespace std::chrono;
 
-// ===================================================================
-//                       HELPER FUNCTIONS
-// ===================================================================
-
-/**
- * @brief Generates a vector of high-quality random integers.
- * @param size The number of integers to generate.
- * @return A vector<int> filled with random integers.
- */
-vector<int> generateRandomVector(int size) {
-    vector<int> vec(size);
-
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> distrib(0, 100000);
-
-    for (int i = 0; i < size; ++i)
-        vec[i] = distrib(gen);
-
-    return vec;
-}
-
-// ===================================================================
-//                       BINARY SEARCH
-// ===================================================================
-
-/**
- * @brief Iterative Binary Search algorithm.
- * @param arr A sorted vector<int>.
- * @param target The value to find.
- * @return Index of target if found, else -1.
- */
-int binarySearch(const vector<int>& arr, int target) {
-    int low = 0, high = arr.size() - 1;
-
-    while (low <= high) {
-        int mid = low + (high - low) / 2;
-        if (arr[mid] == target) return mid;
-        if (arr[mid] < target) low = mid + 1;
-        else high = mid - 1;
-    }
-    return -1;
-}
-
 // ===================================================================
 //                          MAIN FUNCTION
 // ===================================================================
 
-int main() {
+int main(int argc, char** argv) {
     vector<int> n_values = {1, 10, 100, 1000, 10000};
-    int runs_per_n = 30;
 
     // Use a single CSV for all algorithms
-    ofstream csv("benchmark_results.csv", ios::app); // append mode
-    if (csv.tellp() == 0) csv << "Algorithm, InputSize, Time_ns\n"; // header if empty
+    bench::ResultWriter csv; // append mode, header only if new
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
 
     cout << "--- Binary Search Benchmark ---" << endl;
-    cout << "Averaged over " << runs_per_n << " runs per input size.\n" << endl;
+    cout << "Per-call times; fast calls are batched to hide clock overhead.\n" << endl;
 
     for (int n : n_values) {
-        long long total_duration = 0;
+        vector<int> data = loadDataset({Distribution::Sorted, (size_t)n}); // must be sorted before searching
+        int target = -1;
 
-        for (int i = 0; i < runs_per_n; ++i) {
-            vector<int> data = generateRandomVector(n);
-            sort(data.begin(), data.end()); // must sort before searching
-            int target = -1;
+        bench::Stats stats = bench::measure("BinarySearch", n, [&] {
+            bench::doNotOptimize(binarySearch(data, target));
+        });
 
-            auto start = high_resolution_clock::now();
-            binarySearch(data, target);
-            auto end = high_resolution_clock::now();
+        bench::printStats(stats);
 
-            total_duration += duration_cast<nanoseconds>(end - start).count();
-        }
+        // Save results with Algorithm name for legend
+        csv.write(stats);
+    }
 
-        long long avg_duration = total_duration / runs_per_n;
+    // ---------------------------------------------------------------
+    //        Static layouts: Eytzinger and S-tree vs. bisection
+    // ---------------------------------------------------------------
+    long long max_n = argc > 1 ? atoll(argv[1]) : 10000000;
+
+    // Random targets, cycled through so consecutive lookups touch
+    // unrelated parts of the array (no artificially warm cache).
+    const int num_queries = 1 << 16;
+    vector<int> queries = loadDataset({Distribution::Uniform, (size_t)num_queries, kDefaultSeed + 1});
+    for (int& q : queries) q -= 50;  // a few below the minimum
+
+    bench::Config cfg;
+    cfg.samples = 15;
+
+    cout << "\n--- Static Search Layouts (random lookups) ---" << endl;
+
+    for (long long n = 1000; n <= max_n; n *= 10) {
+        vector<int> data = loadDataset({Distribution::Sorted, (size_t)n});
+
+        auto build_start = bench::Clock::now();
+        EytzingerIndex eytzinger(data);
+        double eytzinger_build = bench::elapsedNs(build_start, bench::Clock::now());
+        build_start = bench::Clock::now();
+        STreeIndex stree(data);
+        double stree_build = bench::elapsedNs(build_start, bench::Clock::now());
+
+        // Same answers as the sorted array, for every query
+        for (int q : queries) {
+            int lb = lower_bound(data.begin(), data.end(), q) - data.begin();
+            bool present = lb < n && data[lb] == q;
+            if (eytzinger.lowerBound(q) != lb || stree.lowerBound(q) != lb ||
+                (eytzinger.find(q) >= 0) != present || (stree.find(q) >= 0) != present ||
+                (present && (data[eytzinger.find(q)] != q || data[stree.find(q)] != q))) {
+                cerr << "Error: search layouts disagree with the sorted array for " << q << endl;
+                return 1;
+            }
+        }
 
-        cout << "n=" << n << " | Avg Time = " << avg_duration << " ns" << endl;
+        cout << "n=" << n << fixed << setprecision(1)
+             << " | Eytzinger: build " << eytzinger_build / 1e6 << " ms, "
+             << eytzinger.memoryBytes() / 1048576.0 << " MiB"
+             << " | S-tree: build " << stree_build / 1e6 << " ms, "
+             << stree.memoryBytes() / 1048576.0 << " MiB" << defaultfloat << endl;
+
+        size_t qi = 0;
+        auto next_query = [&] { return queries[qi++ & (num_queries - 1)]; };
+
+        vector<bench::Stats> results = {
+            bench::measure("BinarySearch_random", n, [&] {
+                bench::doNotOptimize(binarySearch(data, next_query()));
+            }, cfg),
+            bench::measure("EytzingerSearch", n, [&] {
+                bench::doNotOptimize(eytzinger.find(next_query()));
+            }, cfg),
+            bench::measure("STreeSearch", n, [&] {
+                bench::doNotOptimize(stree.find(next_query()));
+            }, cfg),
+        };
+
+        for (const bench::Stats& stats : results) {
+            cout << "  " << setw(20) << left << stats.algorithm << right;
+            bench::printStats(stats);
+            csv.write(stats);
+        }
+    }
 
-        // Save results with Algorithm name for legend
-        csv << "BinarySearch," << n << "," << avg_duration << "\n";
+    // ---------------------------------------------------------------
+    //        Batched lookups: one call per batch vs. one per target
+    // ---------------------------------------------------------------
+    cout << "\n--- Batched Binary Search (queries per second) ---" << endl;
+
+    bench::Config batch_cfg;
+    batch_cfg.warmupSamples = 1;
+    batch_cfg.samples = 10;
+
+    for (long long n = 100000; n <= max_n; n *= 10) {
+        vector<int> data = loadDataset({Distribution::Sorted, (size_t)n});
+
+        for (int batch : {1024, 1 << 16, 1 << 20}) {
+            vector<int> targets = loadDataset({Distribution::Uniform, (size_t)batch, kDefaultSeed + 1});
+            vector<int> results(batch);
+
+            bench::Stats singles = bench::measure(
+                "BinarySearchLoop_b" + to_string(batch), n, [&] {
+                    for (int i = 0; i < batch; ++i) results[i] = binarySearch(data, targets[i]);
+                }, batch_cfg);
+            vector<int> expected = results;
+
+            bench::Stats batched = bench::measure(
+                "BinarySearchBatch_b" + to_string(batch), n, [&] {
+                    binarySearchBatch(data, targets.data(), batch, results.data());
+                }, batch_cfg);
+
+            // Duplicate keys may be found at different positions; compare values.
+            for (int i = 0; i < batch; ++i) {
+                if ((results[i] < 0) != (expected[i] < 0) || (results[i] >= 0 && data[results[i]] != targets[i])) {
+                    cerr << "Error: binarySearchBatch disagrees with binarySearch" << endl;
+                    return 1;
+                }
+            }
+
+            cout << "n=" << n << " batch=" << batch << fixed << setprecision(1)
+                 << " | loop: " << batch / singles.medianNs * 1e3 << " Mq/s"
+                 << " | batch: " << batch / batched.medianNs * 1e3 << " Mq/s"
+                 << " | speedup " << setprecision(2) << singles.medianNs / batched.medianNs << "x"
+                 << defaultfloat << endl;
+            csv.write(singles);
+            csv.write(batched);
+        }
     }
 
-    csv.close();
-    cout << "\nResults appended to benchmark_results.csv" << endl;
+    cout << "\nResults appended to " << csv.path() << endl;
 
     return 0;
 }
@@ -0,0 +1,210 @@
+// ===================================================================
+//                       BINARY SEARCH ALGORITHMS
+// ===================================================================
+//
+// Classic searches over a sorted range, shared by binarySearch.cpp and
+// the programs that compare against them.
+//
+// Key Notes:
+// - binarySearch() answers "where is target?" (index or -1).
+// - lowerBoundSearch() answers "where would target go?" (index of
+//   the first element >= target, or arr.size()), like std::lower_bound.
+// - Both are the branchy textbook bisection; the cache-friendly static
+//   layouts live in searchLayouts.h, and the searches that use the key
+//   values (interpolation search, learned index) in learnedIndex.h.
+// - Both are templates over the element type, a comparator and a
+//   projection (see ordering.h), take a vector or an iterator range,
+//   and return 64-bit indices:
+//       binarySearch(recs.begin(), recs.end(), key, {}, &Record::key);
+// - binarySearchBatch() / lowerBoundBatch() answer many targets in one
+//   call. Small batches run 16 branchless searches in lock-step, so
+//   their cache misses overlap instead of being paid one after the
+//   other. Large batches (relative to n) are sorted once and answered
+//   by one forward galloping walk over the array. They stay int-only.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "ordering.h"  // Identity
+#include "radixSort.h"
+
+// ===================================================================
+//                       BINARY SEARCH
+// ===================================================================
+
+/**
+ * @brief Iterative lower bound over [first, last): the first element
+ *        whose key is not before target.
+ * @param first, last A range sorted by comp on proj(element).
+ * @param target The key to look for.
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ * @return Index of the first element >= target, or last - first if none.
+ */
+template <class RandomIt, class Key, class Compare = std::less<>, class Proj = Identity>
+inline ptrdiff_t lowerBoundSearch(RandomIt first, RandomIt last, const Key& target, Compare comp = {},
+                                  Proj proj = {}) {
+    ptrdiff_t low = 0, high = last - first;
+
+    while (low < high) {
+        ptrdiff_t mid = low + (high - low) / 2;
+        if (comp(std::invoke(proj, first[mid]), target)) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief Iterative Binary Search over [first, last).
+ * @param first, last A range sorted by comp on proj(element).
+ * @param target The key to find.
+ * @return Index of an element with key equivalent to target, else -1.
+ */
+template <class RandomIt, class Key, class Compare = std::less<>, class Proj = Identity>
+inline ptrdiff_t binarySearch(RandomIt first, RandomIt last, const Key& target, Compare comp = {}, Proj proj = {}) {
+    ptrdiff_t low = 0, high = (last - first) - 1;
+
+    while (low <= high) {
+        ptrdiff_t mid = low + (high - low) / 2;
+        const auto& key = std::invoke(proj, first[mid]);
+        if (comp(key, target)) low = mid + 1;
+        else if (comp(target, key)) high = mid - 1;
+        else return mid;
+    }
+    return -1;
+}
+
+/**
+ * @brief Iterative Binary Search algorithm.
+ * @param arr A sorted vector.
+ * @param target The value to find.
+ * @return Index of target if found, else -1.
+ */
+template <class T, class Key, class Compare = std::less<>, class Proj = Identity>
+inline ptrdiff_t binarySearch(const std::vector<T>& arr, const Key& target, Compare comp = {}, Proj proj = {}) {
+    return binarySearch(arr.begin(), arr.end(), target, comp, proj);
+}
+
+/**
+ * @brief Iterative lower bound (first element >= target).
+ * @param arr A sorted vector.
+ * @param target The value to look for.
+ * @return Index of the first element >= target, or arr.size() if none.
+ */
+template <class T, class Key, class Compare = std::less<>, class Proj = Identity>
+inline ptrdiff_t lowerBoundSearch(const std::vector<T>& arr, const Key& target, Compare comp = {}, Proj proj = {}) {
+    return lowerBoundSearch(arr.begin(), arr.end(), target, comp, proj);
+}
+
+// ===================================================================
+//                      BATCHED BINARY SEARCH
+// ===================================================================
+
+namespace search_detail {
+
+// Number of searches advanced in lock-step.
+constexpr size_t kInterleave = 16;
+// Sort the batch once it holds at least n / kSortedBatchRatio targets.
+constexpr size_t kSortedBatchRatio = 16;
+// ... and never for batches smaller than this.
+constexpr size_t kSortedBatchMin = 4096;
+
+/**
+ * @brief Lower bounds of targets[0,count) by interleaved branchless
+ *        bisection. Every search takes the same number of steps, so a
+ *        group of kInterleave searches shares one loop and each step
+ *        prefetches the exact element its search probes next.
+ */
+inline void interleavedLowerBound(const int* arr, size_t n, const int* targets, size_t count,
+                                  int* out) {
+    for (size_t g0 = 0; g0 < count; g0 += kInterleave) {
+        size_t group = std::min(kInterleave, count - g0);
+        const int* t = targets + g0;
+        size_t base[kInterleave] = {};
+
+        size_t len = n;
+        while (len > 1) {
+            size_t half = len / 2;
+            size_t nextHalf = (len - half) / 2;
+            for (size_t g = 0; g < group; ++g) {
+                base[g] += (arr[base[g] + half - 1] < t[g]) * half;
+                if (nextHalf) __builtin_prefetch(arr + base[g] + nextHalf - 1);
+            }
+            len -= half;
+        }
+        for (size_t g = 0; g < group; ++g)
+            out[g0 + g] = (int)(base[g] + (n > 0 && arr[base[g]] < t[g]));
+    }
+}
+
+/**
+ * @brief Lower bounds of a large batch: sort the targets (remembering
+ *        where each came from), then gallop forward through the array,
+ *        so the whole batch costs about one pass over the data.
+ */
+inline void sortedLowerBound(const int* arr, size_t n, const int* targets, size_t count, int* out) {
+    std::vector<int> keys(targets, targets + count);
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    radixSortPairs(keys, order);
+
+    size_t pos = 0;
+    for (size_t q = 0; q < count; ++q) {
+        int x = keys[q];
+        // Exponential probe from the previous answer, then bisect.
+        size_t step = 1, lo = pos, hi = pos;
+        while (hi < n && arr[hi] < x) {
+            lo = hi + 1;
+            hi = pos + step;
+            step *= 2;
+        }
+        hi = std::min(hi, n);
+        pos = std::lower_bound(arr + lo, arr + hi, x) - arr;
+        out[order[q]] = (int)pos;
+    }
+}
+
+}  // namespace search_detail
+
+/**
+ * @brief Lower bound of every target (first element >= target, or n).
+ * @param arr     A sorted vector<int>.
+ * @param targets Pointer to the targets.
+ * @param count   Number of targets.
+ * @param results Output, one index per target (same order).
+ */
+inline void lowerBoundBatch(const std::vector<int>& arr, const int* targets, size_t count,
+                            int* results) {
+    using namespace search_detail;
+    if (count >= kSortedBatchMin && count >= arr.size() / kSortedBatchRatio)
+        sortedLowerBound(arr.data(), arr.size(), targets, count, results);
+    else
+        interleavedLowerBound(arr.data(), arr.size(), targets, count, results);
+}
+
+/**
+ * @brief binarySearch() for every target: index of target, or -1.
+ * @param arr     A sorted vector<int>.
+ * @param targets Pointer to the targets.
+ * @param count   Number of targets.
+ * @param results Output, one index per target (same order).
+ */
+inline void binarySearchBatch(const std::vector<int>& arr, const int* targets, size_t count,
+                              int* results) {
+    lowerBoundBatch(arr, targets, count, results);
+    for (size_t i = 0; i < count; ++i) {
+        int pos = results[i];
+        if (pos == (int)arr.size() || arr[pos] != targets[i]) results[i] = -1;
+    }
+}
+
+/**
+ * @brief Convenience overload: returns one index per target.
+ */
+inline std::vector<int> binarySearchBatch(const std::vector<int>& arr, const std::vector<int>& targets) {
+    std::vector<int> results(targets.size());
+    binarySearchBatch(arr, targets.data(), targets.size(), results.data());
+    return results;
+}
@@ -0,0 +1,152 @@
+// ===================================================================
+//                 DATASET GENERATOR BENCHMARK PROGRAM
+// ===================================================================
+//
+// Measures how fast every input profile of datasetGenerator.h is
+// generated, on one thread and on all threads, and how fast a cached
+// copy is mapped and read back.
+//
+// Usage: ./datasetGenerator [N]     (default N = 10000000)
+//
+// Key Notes:
+// - The generated bytes must be identical for every thread count, and
+//   the cached file must hold exactly those bytes.
+// - Each profile is checked for its shape (sorted, reversed, value
+//   range, number of distinct keys, ...).
+// - The cache lives in $ALGO_DATASET_DIR or the temp directory; the
+//   first run writes it, later runs only map it.
+//
+// Build: g++ -O2 -pthread datasetGenerator.cpp -o datasetGenerator
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"         // Shared timing harness + CSV writer
+#include "datasetGenerator.h"  // generateDataset(), openCachedDataset()
+using namespace std;
+
+/**
+ * @brief Checks the shape a profile promises. Returns an error text, or
+ *        an empty string if the data looks right.
+ */
+string checkShape(const DatasetSpec& spec, const vector<int>& data) {
+    for (int x : data)
+        if (x < spec.minValue || x > spec.maxValue) return "value out of range";
+
+    size_t n = data.size();
+    switch (spec.distribution) {
+        case Distribution::Sorted:
+            if (!is_sorted(data.begin(), data.end())) return "not sorted";
+            break;
+        case Distribution::Reversed:
+            if (!is_sorted(data.rbegin(), data.rend())) return "not reversed";
+            break;
+        case Distribution::OrganPipe:
+            if (!is_sorted(data.begin(), data.begin() + n / 2) || !is_sorted(data.rbegin(), data.rend() - n / 2))
+                return "not ascending then descending";
+            break;
+        case Distribution::NearlySorted: {
+            size_t descents = 0;
+            for (size_t i = 1; i < n; ++i) descents += data[i] < data[i - 1];
+            if (descents > n * spec.nearlySortedFraction * 2 + 16) return "too many descents";
+            break;
+        }
+        case Distribution::FewUnique: {
+            set<int> keys(data.begin(), data.end());
+            if (keys.size() > (size_t)spec.uniqueKeys) return "too many distinct values";
+            break;
+        }
+        case Distribution::Zipf: {
+            // The most frequent value must be the smallest rank.
+            size_t rank1 = count(data.begin(), data.end(), spec.minValue);
+            size_t rank2 = count(data.begin(), data.end(), spec.minValue + 1);
+            if (n >= 1000 && rank1 <= rank2) return "rank 1 is not the most frequent";
+            break;
+        }
+        case Distribution::KSorted: {
+            // Every value lies between the sorted values d - 1 places either side.
+            vector<int> sorted = data;
+            sort(sorted.begin(), sorted.end());
+            size_t d = (size_t)max(1, spec.sortedDistance);
+            for (size_t i = 0; i < n; ++i)
+                if (data[i] < sorted[i >= d - 1 ? i - (d - 1) : 0] || data[i] > sorted[min(n - 1, i + d - 1)])
+                    return "element too far from its sorted place";
+            break;
+        }
+        default:
+            break;
+    }
+    return "";
+}
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? stoull(argv[1]) : 10000000;
+    unsigned max_threads = max(1u, thread::hardware_concurrency());
+    ThreadPool pool(max_threads);
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 5;
+
+    bench::ResultWriter csv;
+    cout << "--- Dataset Generation (n=" << n << ", cache in " << datasetCacheDir() << ") ---\n" << endl;
+    cout << left << setw(15) << "Profile" << right << setw(12) << "t1 ms" << setw(12) << ("t" + to_string(max_threads) + " ms")
+         << setw(12) << "Melem/s" << setw(12) << "open us" << setw(12) << "read ms" << endl;
+
+    for (Distribution distribution : allDistributions()) {
+        DatasetSpec spec{distribution, n};
+        string profile = distributionName(distribution);
+        vector<bench::Stats> results;
+
+        vector<int> serial, parallel;
+        results.push_back(bench::measure("Dataset_" + profile + "_t1", n, [&] {
+            serial = generateDataset(spec);
+        }, cfg));
+        results.push_back(bench::measure("Dataset_" + profile + "_t" + to_string(max_threads), n, [&] {
+            parallel = generateDataset(spec, &pool);
+        }, cfg));
+        if (serial != parallel) {
+            cerr << "Error: " << profile << " differs between 1 and " << max_threads << " threads" << endl;
+            return 1;
+        }
+        string problem = checkShape(spec, serial);
+        if (!problem.empty()) {
+            cerr << "Error: " << profile << " data is wrong: " << problem << endl;
+            return 1;
+        }
+
+        // ---- cache: write once (if missing), then map / read ----
+        MappedDataset cached;
+        if (!openCachedDataset(spec, cached, &pool)) {
+            cerr << "Error: could not cache " << datasetCachePath(spec) << endl;
+            return 1;
+        }
+        if (!equal(serial.begin(), serial.end(), cached.view().begin())) {
+            cerr << "Error: cached " << profile << " differs from the generated data" << endl;
+            return 1;
+        }
+        string path = datasetCachePath(spec);
+        results.push_back(bench::measure("Dataset_" + profile + "_cache_open", n, [&] {
+            MappedDataset d;
+            bench::doNotOptimize(d.open(path, spec));
+        }, cfg));
+        results.push_back(bench::measure("Dataset_" + profile + "_cache_read", n, [&] {
+            vector<int> v = cached.toVector();
+            bench::doNotOptimize(v.data());
+        }, cfg));
+
+        cout << left << setw(15) << profile << right << fixed << setprecision(2)
+             << setw(12) << results[0].medianNs / 1e6 << setw(12) << results[1].medianNs / 1e6
+             << setw(12) << n / results[1].medianNs * 1e3 << setw(12) << results[2].medianNs / 1e3
+             << setw(12) << results[3].medianNs / 1e6 << defaultfloat << endl;
+        if (csv.isOpen())
+            for (const bench::Stats& s : results) csv.write(s);
+    }
+
+    if (csv.isOpen()) cout << "\nResults appended to " << csv.path() << endl;
+    return 0;
+}
@@ -0,0 +1,446 @@
+// ===================================================================
+//              REPRODUCIBLE BENCHMARK DATASET GENERATOR
+// ===================================================================
+//
+// One place that builds the int inputs of every benchmark program,
+// replacing the per-file generateRandomVector() copies.
+//
+// Key Notes:
+// - Every dataset is fully described by a DatasetSpec (distribution,
+//   size, seed, value range, shape parameters). The same spec gives the
+//   same bytes on every run, machine and thread count.
+// - Random numbers come from a COUNTER-BASED generator: element i is
+//   a hash of (seed, i), with no generator state carried from one
+//   element to the next. Threads can fill any slice independently and
+//   the result does not depend on how the work was split.
+// - Shaped profiles (sorted, reversed, nearly-sorted, k-sorted,
+//   organ-pipe) are
+//   built by sorting the uniform data (counting sort for small value
+//   ranges, else the parallel radix sort), so they hold exactly the
+//   same values as the uniform profile.
+// - Zipf uses rejection-inversion sampling (Hormann & Derflinger):
+//   O(1) expected time and no table, whatever the value range.
+// - loadDataset() caches large datasets as files in a cache directory
+//   ($ALGO_DATASET_DIR, or a temp subdirectory) and maps them on later
+//   calls, so a big sweep generates each input only once and every
+//   algorithm reads the same bytes.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "mappedFile.h"  // MappedFile, ArrayView
+#include "radixSort.h"   // parallel sort for the shaped profiles
+#include "threadPool.h"
+
+/**
+ * @brief Shape of the generated values.
+ */
+enum class Distribution {
+    Uniform,       // independent uniform values in [minValue, maxValue]
+    Sorted,        // the uniform values, ascending
+    Reversed,      // the uniform values, descending
+    NearlySorted,  // sorted, then a fraction of elements swapped locally
+    FewUnique,     // uniformly chosen from uniqueKeys distinct values
+    Zipf,          // value minValue + k - 1 with P(k) ~ 1 / k^zipfExponent
+    OrganPipe,     // ascending first half, descending second half
+    KSorted,       // sorted, then every element moved < sortedDistance places
+};
+
+constexpr uint64_t kDefaultSeed = 42;
+
+/**
+ * @brief Everything that determines a dataset.
+ */
+struct DatasetSpec {
+    Distribution distribution = Distribution::Uniform;
+    size_t size = 0;
+    uint64_t seed = kDefaultSeed;
+    int minValue = 0;
+    int maxValue = 100000;
+    double nearlySortedFraction = 0.01;  // share of elements moved (NearlySorted)
+    int uniqueKeys = 16;                 // distinct values (FewUnique)
+    double zipfExponent = 1.0;           // skew (Zipf), > 0
+    int sortedDistance = 64;             // max displacement + 1 (KSorted)
+};
+
+/**
+ * @brief Profile name used in output and CSV algorithm names.
+ */
+inline const char* distributionName(Distribution d) {
+    switch (d) {
+        case Distribution::Uniform: return "uniform";
+        case Distribution::Sorted: return "sorted";
+        case Distribution::Reversed: return "reversed";
+        case Distribution::NearlySorted: return "nearly-sorted";
+        case Distribution::FewUnique: return "few-unique";
+        case Distribution::Zipf: return "zipf";
+        case Distribution::OrganPipe: return "organ-pipe";
+        case Distribution::KSorted: return "k-sorted";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief All profiles, in a fixed order for benchmark loops.
+ */
+inline const std::vector<Distribution>& allDistributions() {
+    static const std::vector<Distribution> all = {
+        Distribution::Uniform,   Distribution::Sorted, Distribution::Reversed, Distribution::NearlySorted,
+        Distribution::FewUnique, Distribution::Zipf,   Distribution::OrganPipe, Distribution::KSorted,
+    };
+    return all;
+}
+
+namespace dataset_detail {
+
+// Elements per parallel task, and per NearlySorted shuffle window.
+constexpr size_t kGrain = 1 << 16;
+constexpr size_t kNearlySortedWindow = 1024;
+// Value ranges up to this size are sorted by counting instead of radix.
+constexpr uint64_t kCountingSortMaxRange = 1 << 24;
+// Smaller datasets are cheaper to generate than to cache.
+constexpr size_t kCacheMinElements = 1 << 20;
+constexpr uint32_t kCacheVersion = 2;
+
+/**
+ * @brief SplitMix64 finalizer: a bijective 64-bit mixer.
+ */
+inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Counter-based generator: random word number @p counter of
+ *        stream @p stream under @p seed. Pure function, no state.
+ */
+inline uint64_t counterRandom(uint64_t seed, uint64_t stream, uint64_t counter) {
+    uint64_t key = mix64(seed ^ mix64(stream + 0x632BE59BD9B4E019ull));
+    return mix64(key + (counter + 1) * 0x9E3779B97F4A7C15ull);
+}
+
+/**
+ * @brief Maps a random word to [0, range) (multiply-shift, no division).
+ */
+inline uint64_t bounded(uint64_t random, uint64_t range) {
+    return (uint64_t)(((unsigned __int128)random * range) >> 64);
+}
+
+/**
+ * @brief Random word to a double in [0, 1).
+ */
+inline double unitDouble(uint64_t random) { return (double)(random >> 11) * 0x1.0p-53; }
+
+/**
+ * @brief Zipf(s) sampler on 1..N by rejection-inversion.
+ */
+class ZipfSampler {
+public:
+    ZipfSampler(uint64_t n, double exponent) : n_((double)n), s_(exponent) {
+        hIntegralX1_ = hIntegral(1.5) - 1.0;
+        hIntegralN_ = hIntegral(n_ + 0.5);
+        threshold_ = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+    }
+
+    /**
+     * @brief Rank of element @p index (attempts draw from fresh streams).
+     */
+    uint64_t sample(uint64_t seed, uint64_t index) const {
+        for (uint64_t attempt = 0;; ++attempt) {
+            double u = hIntegralN_ + unitDouble(counterRandom(seed, 1 + attempt, index)) * (hIntegralX1_ - hIntegralN_);
+            double x = hIntegralInverse(u);
+            double k = std::min(std::max(std::floor(x + 0.5), 1.0), n_);
+            if (k - x <= threshold_ || u >= hIntegral(k + 0.5) - h(k)) return (uint64_t)k;
+        }
+    }
+
+private:
+    // log1p(x) / x and expm1(x) / x, both -> 1 as x -> 0.
+    static double helper1(double x) { return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x / 3.0); }
+    static double helper2(double x) { return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0); }
+
+    double h(double x) const { return std::exp(-s_ * std::log(x)); }
+    double hIntegral(double x) const {
+        double logX = std::log(x);
+        return helper2((1.0 - s_) * logX) * logX;
+    }
+    double hIntegralInverse(double x) const {
+        double t = x * (1.0 - s_);
+        if (t < -1.0) t = -1.0;  // numerical safety near the lower end
+        return std::exp(helper1(t) * x);
+    }
+
+    double n_, s_;
+    double hIntegralX1_, hIntegralN_, threshold_;
+};
+
+/**
+ * @brief Runs body(lo, hi) over [0, n), on the pool if there is one.
+ */
+template <class Body>
+void forRange(ThreadPool* pool, size_t n, Body&& body) {
+    if (pool) pool->parallelFor(0, n, kGrain, body);
+    else body(0, n);
+}
+
+/**
+ * @brief Sorts values from [minValue, minValue + range) by counting:
+ *        one histogram pass and one fill pass, O(n + range).
+ */
+inline void countingSort(std::vector<int>& v, int minValue, uint64_t range, ThreadPool* pool) {
+    std::vector<size_t> start(range + 1, 0);
+    for (int x : v) start[(uint64_t)((int64_t)x - minValue) + 1]++;
+    for (uint64_t k = 0; k < range; ++k) start[k + 1] += start[k];
+
+    // Each task fills the output slots of a slice of the value range.
+    size_t grain = std::max<size_t>(1, range / 64);
+    auto fill = [&](size_t lo, size_t hi) {
+        for (size_t k = lo; k < hi; ++k)
+            std::fill(v.begin() + start[k], v.begin() + start[k + 1], (int)(minValue + (int64_t)k));
+    };
+    if (pool) pool->parallelFor(0, range, grain, fill);
+    else fill(0, range);
+}
+
+/**
+ * @brief File header of a cached dataset (followed by size ints,
+ *        starting at byte kDataOffset).
+ */
+struct CacheHeader {
+    char magic[8];  // "DATASET\0"
+    uint32_t version;
+    uint32_t elementBytes;
+    DatasetSpec spec;
+};
+constexpr size_t kDataOffset = 128;
+static_assert(sizeof(CacheHeader) <= kDataOffset, "dataset header must fit before the data");
+constexpr char kCacheMagic[8] = {'D', 'A', 'T', 'A', 'S', 'E', 'T', '\0'};
+
+inline bool sameSpec(const DatasetSpec& a, const DatasetSpec& b) {
+    return a.distribution == b.distribution && a.size == b.size && a.seed == b.seed && a.minValue == b.minValue &&
+           a.maxValue == b.maxValue && a.nearlySortedFraction == b.nearlySortedFraction &&
+           a.uniqueKeys == b.uniqueKeys && a.zipfExponent == b.zipfExponent &&
+           a.sortedDistance == b.sortedDistance;
+}
+
+}  // namespace dataset_detail
+
+// ===================================================================
+//                           GENERATION
+// ===================================================================
+
+/**
+ * @brief Writes elements [first, first + count) of the Uniform profile
+ *        of @p spec to @p out. Every element depends only on the seed
+ *        and its index, so a dataset too large for memory can be
+ *        produced block by block (e.g. straight into a file).
+ */
+inline void generateUniformBlock(const DatasetSpec& spec, uint64_t first, size_t count, int* out,
+                                 ThreadPool* pool = nullptr) {
+    using namespace dataset_detail;
+    if (spec.maxValue < spec.minValue) throw std::invalid_argument("generateDataset: maxValue < minValue");
+    const uint64_t range = (uint64_t)((int64_t)spec.maxValue - spec.minValue) + 1;
+    forRange(pool, count, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            out[i] = (int)(spec.minValue + (int64_t)bounded(counterRandom(spec.seed, 0, first + i), range));
+    });
+}
+
+/**
+ * @brief Generates the dataset described by @p spec in memory.
+ *
+ * @param pool Threads to generate with (nullptr = calling thread only).
+ *             The result is identical either way.
+ */
+inline std::vector<int> generateDataset(const DatasetSpec& spec, ThreadPool* pool = nullptr) {
+    using namespace dataset_detail;
+    if (spec.maxValue < spec.minValue) throw std::invalid_argument("generateDataset: maxValue < minValue");
+    const size_t n = spec.size;
+    const uint64_t range = (uint64_t)((int64_t)spec.maxValue - spec.minValue) + 1;
+    std::vector<int> out(n);
+
+    switch (spec.distribution) {
+        case Distribution::FewUnique: {
+            uint64_t keys = std::min<uint64_t>((uint64_t)std::max(1, spec.uniqueKeys), range);
+            uint64_t step = range / keys;
+            forRange(pool, n, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i)
+                    out[i] = (int)(spec.minValue + (int64_t)(bounded(counterRandom(spec.seed, 0, i), keys) * step));
+            });
+            return out;
+        }
+        case Distribution::Zipf: {
+            if (!(spec.zipfExponent > 0)) throw std::invalid_argument("generateDataset: zipfExponent must be > 0");
+            ZipfSampler zipf(range, spec.zipfExponent);
+            forRange(pool, n, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) out[i] = (int)(spec.minValue + (int64_t)zipf.sample(spec.seed, i) - 1);
+            });
+            return out;
+        }
+        default:
+            generateUniformBlock(spec, 0, n, out.data(), pool);
+            break;
+    }
+    if (spec.distribution == Distribution::Uniform) return out;
+
+    if (range <= kCountingSortMaxRange && range <= 4 * (uint64_t)n) countingSort(out, spec.minValue, range, pool);
+    else radixSort(out, pool);
+    if (spec.distribution == Distribution::Reversed) {
+        std::reverse(out.begin(), out.end());
+    } else if (spec.distribution == Distribution::OrganPipe) {
+        std::reverse(out.begin() + n / 2, out.end());
+    } else if (spec.distribution == Distribution::NearlySorted) {
+        // Random swaps inside fixed windows: each element moves at most a
+        // window away, and windows can be shuffled independently.
+        size_t windows = (n + kNearlySortedWindow - 1) / kNearlySortedWindow;
+        double swapsPerWindow = spec.nearlySortedFraction * kNearlySortedWindow / 2.0;
+        forRange(pool, windows, [&](size_t lo, size_t hi) {
+            for (size_t w = lo; w < hi; ++w) {
+                size_t begin = w * kNearlySortedWindow;
+                size_t len = std::min(kNearlySortedWindow, n - begin);
+                // Fractional swap counts are rounded randomly per window.
+                uint64_t r = counterRandom(spec.seed, 2, w);
+                size_t swaps = (size_t)swapsPerWindow + (unitDouble(r) < swapsPerWindow - std::floor(swapsPerWindow));
+                for (size_t s = 0; s < swaps; ++s) {
+                    uint64_t a = counterRandom(spec.seed, 3, w * 2 * kNearlySortedWindow + 2 * s);
+                    uint64_t b = counterRandom(spec.seed, 3, w * 2 * kNearlySortedWindow + 2 * s + 1);
+                    std::swap(out[begin + bounded(a, len)], out[begin + bounded(b, len)]);
+                }
+            }
+        });
+    } else if (spec.distribution == Distribution::KSorted) {
+        // Windows of sortedDistance elements, each fully shuffled: no
+        // element ends up sortedDistance or more places from home.
+        size_t window = (size_t)std::max(1, spec.sortedDistance);
+        size_t windows = (n + window - 1) / window;
+        forRange(pool, windows, [&](size_t lo, size_t hi) {
+            for (size_t w = lo; w < hi; ++w) {
+                size_t begin = w * window;
+                size_t len = std::min(window, n - begin);
+                for (size_t j = len; j > 1; --j)
+                    std::swap(out[begin + j - 1], out[begin + bounded(counterRandom(spec.seed, 4, begin + j), j)]);
+            }
+        });
+    }
+    return out;
+}
+
+// ===================================================================
+//                          ON-DISK CACHE
+// ===================================================================
+
+/**
+ * @brief Directory for cached datasets: $ALGO_DATASET_DIR if set, else
+ *        "algorithm_datasets" in the system temp directory.
+ */
+inline std::string datasetCacheDir() {
+    if (const char* dir = std::getenv("ALGO_DATASET_DIR")) return dir;
+    return (std::filesystem::temp_directory_path() / "algorithm_datasets").string();
+}
+
+/**
+ * @brief Cache file name of a spec (every field that changes the bytes
+ *        is part of the name).
+ */
+inline std::string datasetCachePath(const DatasetSpec& spec) {
+    std::ostringstream name;
+    name << distributionName(spec.distribution) << "_n" << spec.size << "_s" << spec.seed << "_r" << spec.minValue
+         << "_" << spec.maxValue;
+    if (spec.distribution == Distribution::NearlySorted) name << "_f" << spec.nearlySortedFraction;
+    if (spec.distribution == Distribution::FewUnique) name << "_k" << spec.uniqueKeys;
+    if (spec.distribution == Distribution::Zipf) name << "_z" << spec.zipfExponent;
+    if (spec.distribution == Distribution::KSorted) name << "_d" << spec.sortedDistance;
+    name << ".i32";
+    return (std::filesystem::path(datasetCacheDir()) / name.str()).string();
+}
+
+/**
+ * @brief A cached dataset mapped read-only (zero-copy).
+ */
+class MappedDataset {
+public:
+    /**
+     * @brief Maps @p path if it holds exactly the dataset @p spec.
+     */
+    bool open(const std::string& path, const DatasetSpec& spec) {
+        using namespace dataset_detail;
+        MappedFile file;
+        if (!file.open(path) || file.size() < kDataOffset) return false;
+        CacheHeader h;
+        std::memcpy(&h, file.data(), sizeof h);
+        if (std::memcmp(h.magic, kCacheMagic, sizeof kCacheMagic) != 0 || h.version != kCacheVersion ||
+            h.elementBytes != sizeof(int) || !sameSpec(h.spec, spec) ||
+            (file.size() - kDataOffset) / sizeof(int) != spec.size)
+            return false;
+        file_ = std::move(file);
+        view_ = {reinterpret_cast<const int*>(file_.data() + kDataOffset), spec.size};
+        return true;
+    }
+
+    const ArrayView<int>& view() const { return view_; }
+    std::vector<int> toVector() const { return std::vector<int>(view_.begin(), view_.end()); }
+
+private:
+    MappedFile file_;
+    ArrayView<int> view_;
+};
+
+/**
+ * @brief Writes a generated dataset to @p path (via a temp file and a
+ *        rename, so a half-written file is never picked up).
+ */
+inline bool writeDatasetFile(const std::string& path, const DatasetSpec& spec, const std::vector<int>& data) {
+    using namespace dataset_detail;
+    CacheHeader h{};
+    std::memcpy(h.magic, kCacheMagic, sizeof kCacheMagic);
+    h.version = kCacheVersion;
+    h.elementBytes = sizeof(int);
+    h.spec = spec;
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        char header[kDataOffset] = {};
+        std::memcpy(header, &h, sizeof h);
+        out.write(header, kDataOffset);
+        out.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)(data.size() * sizeof(int)));
+        if (!out) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Maps the cached copy of @p spec, generating and writing it
+ *        first if there is none.
+ *
+ * @return false if the cache file can neither be read nor written.
+ */
+inline bool openCachedDataset(const DatasetSpec& spec, MappedDataset& out, ThreadPool* pool = nullptr) {
+    std::string path = datasetCachePath(spec);
+    if (out.open(path, spec)) return true;
+
+    std::error_code ec;
+    std::filesystem::create_directories(datasetCacheDir(), ec);
+    return writeDatasetFile(path, spec, generateDataset(spec, pool)) && out.open(path, spec);
+}
+
+/**
+ * @brief The dataset as a vector: generated directly when small, read
+ *        from (or added to) the cache when large.
+ */
+inline std::vector<int> loadDataset(const DatasetSpec& spec, ThreadPool* pool = nullptr) {
+    if (spec.size < dataset_detail::kCacheMinElements) return generateDataset(spec, pool);
+    MappedDataset cached;
+    if (openCachedDataset(spec, cached, pool)) return cached.toVector();
+    return generateDataset(spec, pool);
+}
@@ -0,0 +1,145 @@
+// ===================================================================
+//              DELTA-STEPPING SHORTEST PATHS PROGRAM
+// ===================================================================
+//
+// Runs the parallel delta-stepping engine of deltaStepping.h on a
+// graph1.txt-style file, checks it against sequential Dijkstra and
+// measures how it scales from 1 thread to all of them.
+//
+// Usage:
+//   ./deltaStepping                      graph1.txt, from its first node
+//   ./deltaStepping FILE [SOURCE]        any graph1.txt-style file
+//   ./deltaStepping --generate FILE N M  write a random N-node, M-edge
+//                                        graph (names v0, v1, ...)
+//
+// Key Notes:
+// - delta is tuned once on all threads (tuneDelta()), then the same
+//   delta is used for every thread count, so the rows differ only in
+//   the threads.
+// - Every run's distances must equal Dijkstra's (radix heap).
+// - The first run parses the text in parallel and saves FILE.csr; later
+//   runs map that snapshot directly (see graphLoader.h).
+// - Times are appended to benchmark_results.csv with the number of
+//   arcs as InputSize.
+//
+// Build: g++ -O2 -pthread deltaStepping.cpp -o deltaStepping
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"      // Shared timing harness + CSV writer
+#include "deltaStepping.h"  // DeltaStepping
+#include "dijkstra.h"       // dijkstra<RadixHeap>()
+#include "graphLoader.h"    // loadGraphCached(), CsrView
+using namespace std;
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    if (argc == 5 && string(argv[1]) == "--generate") {
+        size_t nodes = stoull(argv[3]), edges = stoull(argv[4]);
+        if (!writeRandomGraphText(argv[2], nodes, edges, 100, 42)) {
+            cerr << "Error: could not write " << argv[2] << endl;
+            return 1;
+        }
+        cout << "Wrote " << edges << " edges over " << nodes << " nodes to " << argv[2] << endl;
+        return 0;
+    }
+
+    string file_name = argc > 1 ? argv[1] : "graph1.txt";
+    unsigned max_threads = max(1u, thread::hardware_concurrency());
+    ThreadPool all_threads(max_threads);
+
+    // ---- load phase ----
+    LoadedGraph loaded;
+    GraphLoadInfo load_info;
+    if (!loadGraphCached(file_name, EdgeListFormat::CountThenEdges, loaded, &all_threads, &load_info)) return 1;
+    const CsrView& graph = loaded.view();
+    if (graph.nodeCount() == 0) {
+        cerr << "Error: " << file_name << " has no edges" << endl;
+        return 1;
+    }
+    if (!hasNonNegativeWeights(graph)) {
+        cerr << "Error: delta-stepping needs non-negative weights (use bellmanFord for " << file_name << ")"
+             << endl;
+        return 1;
+    }
+
+    string source_name = argc > 2 ? argv[2] : string(graph.names.front());
+    long long source_id = graph.idOf(source_name);
+    if (source_id < 0) {
+        cerr << "Error: unknown node " << source_name << endl;
+        return 1;
+    }
+    NodeId source = (NodeId)source_id;
+    long long m = (long long)graph.arcCount();
+    cout << "Loaded " << file_name << ": " << graph.nodeCount() << " nodes, " << m << " arcs" << endl;
+
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 5;
+
+    // ---- reference ----
+    ShortestPaths reference;
+    bench::Stats dijkstra_stats = bench::measure("Dijkstra_RadixHeap", m, [&] {
+        reference = dijkstra<RadixHeap>(graph, source);
+    }, cfg);
+    cout << "\n" << setw(26) << left << "Dijkstra (radix heap)" << right;
+    bench::printStats(dijkstra_stats);
+    csv.write(dijkstra_stats);
+
+    // ---- delta ----
+    auto build_start = bench::Clock::now();
+    DeltaStepping engine(graph);
+    double build_ns = bench::elapsedNs(build_start, bench::Clock::now());
+    Distance initial_delta = engine.delta();
+    Distance delta = engine.tuneDelta(source, all_threads);
+    cout << "\nEngine build (arcs sorted by weight): " << fixed << setprecision(3) << build_ns / 1e6 << " ms"
+         << defaultfloat << "\nmax weight " << engine.maxWeight() << ", delta " << initial_delta
+         << " (max weight / average degree) -> tuned to " << delta << " on " << max_threads << " threads" << endl;
+
+    // ---- scaling: 1, 2, 4, ... and always the full machine ----
+    vector<unsigned> thread_counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    cout << "\n--- Delta-stepping scaling (delta=" << delta << ") ---" << endl;
+    double one_thread_ns = 0;
+    for (unsigned t : thread_counts) {
+        ThreadPool pool(t);
+        DeltaSteppingResult result;
+        bench::Stats stats = bench::measure("DeltaStepping_t" + to_string(t), m, [&] {
+            result = engine.run(source, pool);
+        }, cfg);
+        if (result.dist != reference.dist) {
+            cerr << "Error: delta-stepping disagrees with Dijkstra on " << t << " threads" << endl;
+            return 1;
+        }
+        if (t == 1) one_thread_ns = stats.medianNs;
+
+        cout << "threads=" << setw(3) << t << " ";
+        bench::printStats(stats);
+        cout << "            " << result.buckets << " buckets, " << result.phases << " phases, "
+             << result.relaxations << " relaxations (" << fixed << setprecision(2)
+             << (double)result.relaxations / (double)max<long long>(1, m) << " per arc); speedup vs Dijkstra = "
+             << dijkstra_stats.medianNs / stats.medianNs << "x, vs 1 thread = " << one_thread_ns / stats.medianNs
+             << "x" << defaultfloat << endl;
+        csv.write(stats);
+    }
+
+    size_t reachable = count_if(reference.dist.begin(), reference.dist.end(),
+                                [](Distance d) { return d != kInfinity; });
+    cout << "\n" << reachable << " of " << graph.nodeCount() << " nodes reachable from " << source_name
+         << "; all distances match Dijkstra" << endl;
+    cout << "Results appended to " << csv.path() << endl;
+
+    return 0;
+}
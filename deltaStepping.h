@@ -0,0 +1,253 @@
+// ===================================================================
+//              PARALLEL DELTA-STEPPING SHORTEST PATHS
+// ===================================================================
+//
+// Single-source shortest paths with non-negative weights that uses
+// every core, where Dijkstra (dijkstra.h) settles one node at a time
+// from a single priority queue.
+//
+//   DeltaStepping engine(graph);          // CsrGraph or CsrView
+//   engine.tuneDelta(source, pool);       // optional, picks delta
+//   DeltaSteppingResult r = engine.run(source, pool);
+//
+// Key Notes:
+// - Nodes are kept in buckets of width delta: bucket i holds the
+//   nodes whose tentative distance is in [i*delta, (i+1)*delta). The
+//   lowest non-empty bucket is processed as a whole, in parallel:
+//     * LIGHT arcs (weight <= delta) can put a node back into the
+//       current bucket, so they are relaxed in phases until the bucket
+//       stays empty,
+//     * HEAVY arcs (weight > delta) can only reach later buckets, so
+//       they are relaxed once, from every node the bucket settled.
+//   delta -> 0 is Dijkstra (one distance per bucket, no parallelism),
+//   delta -> infinity is Bellman-Ford (one bucket, much wasted work).
+// - Distances are std::atomic and lowered with a compare-exchange
+//   loop (atomic min), so threads relax arcs into the same nodes
+//   without locks. A node may be queued more than once; the copies
+//   whose distance moved on are skipped (lazy deletion, like the
+//   queues of dijkstra.h).
+// - Every lane (a slice of the frontier; several per thread) appends
+//   to its own buckets, which live in a ring of maxWeight/delta + 2
+//   slots: no shared queue, no lock.
+// - The engine keeps its own copy of the CSR with each node's arcs
+//   sorted by weight: the light arcs are a prefix, the heavy ones the
+//   rest, for every delta without rebuilding anything.
+// - tuneDelta() times a few deltas around maxWeight / average degree
+//   on one query and keeps the fastest.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "dijkstra.h"  // Distance, kInfinity
+#include "graph.h"
+#include "threadPool.h"
+
+/**
+ * @brief Distances of one delta-stepping search, plus work counters.
+ */
+struct DeltaSteppingResult {
+    std::vector<Distance> dist;  // kInfinity if unreachable
+    size_t reached = 0;          // nodes with a finite distance
+    size_t buckets = 0;          // non-empty buckets processed
+    size_t phases = 0;           // light-arc phases over all buckets
+    size_t relaxations = 0;      // arcs relaxed (light and heavy)
+};
+
+namespace delta_detail {
+
+// Frontiers smaller than this are relaxed on the calling thread.
+constexpr size_t kSerialFrontier = 256;
+
+/**
+ * @brief dist = min(dist, candidate); true if candidate was smaller.
+ */
+inline bool atomicMin(std::atomic<Distance>& dist, Distance candidate) {
+    Distance old = dist.load(std::memory_order_relaxed);
+    while (candidate < old && !dist.compare_exchange_weak(old, candidate, std::memory_order_relaxed)) {}
+    return candidate < old;
+}
+
+}  // namespace delta_detail
+
+class DeltaStepping {
+public:
+    /**
+     * @brief Copies the graph with every node's arcs sorted by weight.
+     * @throws std::invalid_argument on a negative weight.
+     */
+    template <class Graph>
+    explicit DeltaStepping(const Graph& graph) : n_(graph.nodeCount()) {
+        offsets_.assign(graph.offsets.begin(), graph.offsets.end());
+        arcs_.resize(graph.arcCount());
+        uint64_t degreeSum = 0;
+        for (size_t u = 0; u < n_; ++u) {
+            for (uint64_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+                if (graph.weights[e] < 0) throw std::invalid_argument("DeltaStepping: negative arc weight");
+                arcs_[e] = {graph.targets[e], graph.weights[e]};
+                maxWeight_ = std::max<Distance>(maxWeight_, graph.weights[e]);
+            }
+            std::sort(arcs_.begin() + offsets_[u], arcs_.begin() + offsets_[u + 1],
+                      [](const Arc& a, const Arc& b) { return a.weight < b.weight; });
+            degreeSum += offsets_[u + 1] - offsets_[u];
+        }
+        double averageDegree = n_ ? std::max(1.0, (double)degreeSum / (double)n_) : 1.0;
+        delta_ = std::max<Distance>(1, (Distance)((double)maxWeight_ / averageDegree));
+    }
+
+    size_t nodeCount() const { return n_; }
+    Distance maxWeight() const { return maxWeight_; }
+    Distance delta() const { return delta_; }
+    void setDelta(Distance delta) { delta_ = std::max<Distance>(1, delta); }
+
+    /**
+     * @brief Runs one query from @p source for each candidate delta
+     *        (the current one times 1/8 ... 8) and keeps the fastest.
+     * @return The chosen delta.
+     */
+    Distance tuneDelta(NodeId source, ThreadPool& pool) {
+        Distance base = delta_, best = delta_;
+        double bestNs = std::numeric_limits<double>::infinity();
+        for (double factor : {0.125, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0}) {
+            Distance candidate = std::max<Distance>(1, (Distance)std::llround((double)base * factor));
+            if (factor != 1.0 && candidate == base) continue;
+            delta_ = candidate;
+            auto start = std::chrono::steady_clock::now();
+            run(source, pool);
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            if (ns < bestNs) {
+                bestNs = ns;
+                best = candidate;
+            }
+        }
+        delta_ = best;
+        return best;
+    }
+
+    /**
+     * @brief Shortest distances from @p source, on the threads of @p pool.
+     */
+    DeltaSteppingResult run(NodeId source, ThreadPool& pool) const {
+        using namespace delta_detail;
+        DeltaSteppingResult result;
+        std::unique_ptr<std::atomic<Distance>[]> dist(new std::atomic<Distance>[n_]);
+        for (size_t v = 0; v < n_; ++v) dist[v].store(kInfinity, std::memory_order_relaxed);
+
+        const Distance delta = delta_;
+        // A relaxation lands at most maxWeight / delta + 1 buckets ahead.
+        const size_t ring = (size_t)(maxWeight_ / delta) + 2;
+        const size_t lanes = pool.size() == 1 ? 1 : 4 * (size_t)pool.size();
+        std::vector<Lane> lane(lanes);
+        for (Lane& l : lane) l.buckets.resize(ring);
+
+        dist[source].store(0, std::memory_order_relaxed);
+        std::vector<NodeId> frontier = {source};
+
+        // Relaxes the light (or heavy) arcs of u, which has distance du.
+        auto relaxArcs = [&](Lane& l, NodeId u, Distance du, bool light) {
+            uint64_t e = offsets_[u], end = offsets_[u + 1];
+            // Arcs are sorted by weight: light ones first.
+            uint64_t split = (uint64_t)(std::upper_bound(arcs_.begin() + e, arcs_.begin() + end, delta,
+                                                         [](Distance d, const Arc& a) { return d < a.weight; }) -
+                                        arcs_.begin());
+            if (light) end = split;
+            else e = split;
+            for (; e < end; ++e) {
+                Distance nd = du + arcs_[e].weight;
+                ++l.relaxations;
+                if (atomicMin(dist[arcs_[e].to], nd)) l.buckets[(size_t)(nd / delta) % ring].push_back(arcs_[e].to);
+            }
+        };
+        // Runs body(lane, lo, hi) over slices of [0, count).
+        auto forSlices = [&](size_t count, auto&& body) {
+            if (lanes == 1 || count < kSerialFrontier) {
+                body(lane[0], 0, count);
+                return;
+            }
+            size_t step = (count + lanes - 1) / lanes;
+            pool.parallelFor(0, lanes, 1, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) body(lane[i], std::min(count, i * step), std::min(count, (i + 1) * step));
+            });
+        };
+
+        std::vector<NodeId> settled;
+        for (size_t bucket = 0;;) {
+            // ---- light phases: until the bucket stays empty ----
+            settled.clear();
+            while (!frontier.empty()) {
+                ++result.phases;
+                forSlices(frontier.size(), [&](Lane& l, size_t lo, size_t hi) {
+                    for (size_t i = lo; i < hi; ++i) {
+                        NodeId u = frontier[i];
+                        Distance du = dist[u].load(std::memory_order_relaxed);
+                        if ((size_t)(du / delta) != bucket) continue;  // moved to a lower distance copy
+                        l.settled.push_back(u);
+                        relaxArcs(l, u, du, true);
+                    }
+                });
+                frontier.clear();
+                for (Lane& l : lane) {
+                    std::vector<NodeId>& b = l.buckets[bucket % ring];
+                    frontier.insert(frontier.end(), b.begin(), b.end());
+                    b.clear();
+                    settled.insert(settled.end(), l.settled.begin(), l.settled.end());
+                    l.settled.clear();
+                }
+            }
+            ++result.buckets;
+
+            // ---- heavy arcs of everything the bucket settled ----
+            // (a node improved within the bucket is listed once per
+            // phase; its extra copies relax with the same distance)
+            forSlices(settled.size(), [&](Lane& l, size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i)
+                    relaxArcs(l, settled[i], dist[settled[i]].load(std::memory_order_relaxed), false);
+            });
+
+            // ---- next non-empty bucket within the ring ----
+            size_t next = 0;
+            for (size_t ahead = 1; ahead < ring && !next; ++ahead)
+                for (const Lane& l : lane)
+                    if (!l.buckets[(bucket + ahead) % ring].empty()) {
+                        next = bucket + ahead;
+                        break;
+                    }
+            if (!next) break;
+            bucket = next;
+            for (Lane& l : lane) {
+                std::vector<NodeId>& b = l.buckets[bucket % ring];
+                frontier.insert(frontier.end(), b.begin(), b.end());
+                b.clear();
+            }
+        }
+
+        result.dist.resize(n_);
+        for (size_t v = 0; v < n_; ++v) {
+            result.dist[v] = dist[v].load(std::memory_order_relaxed);
+            result.reached += result.dist[v] != kInfinity;
+        }
+        for (const Lane& l : lane) result.relaxations += l.relaxations;
+        return result;
+    }
+
+private:
+    struct Arc {
+        NodeId to;
+        EdgeWeight weight;
+    };
+
+    // Per-lane output, written by one task at a time; a cache line
+    // each, so lanes do not share counters.
+    struct alignas(64) Lane {
+        std::vector<std::vector<NodeId>> buckets;  // ring of future buckets
+        std::vector<NodeId> settled;               // processed in this phase
+        size_t relaxations = 0;
+    };
+
+    size_t n_;
+    std::vector<uint64_t> offsets_;
+    std::vector<Arc> arcs_;
+    Distance maxWeight_ = 0;
+    Distance delta_ = 1;
+};
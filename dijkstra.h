@@ -0,0 +1,211 @@
+// ===================================================================
+//                      DIJKSTRA SHORTEST PATHS
+// ===================================================================
+//
+// Single-source shortest paths on a CSR graph (an in-memory CsrGraph
+// or a mapped CsrView) with non-negative weights, with a choice of
+// priority queue.
+//
+// Key Notes:
+// - Both queues use LAZY DELETION instead of decrease-key: a better
+//   distance is simply pushed again, and stale entries (key larger
+//   than the node's current distance) are skipped when popped. That
+//   keeps the queues simple arrays with no position tracking.
+// - QuadHeap is an implicit 4-ary min-heap: half the depth of a binary
+//   heap and the 4 children of a node sit next to each other in memory.
+// - RadixHeap exploits that Dijkstra pops keys in non-decreasing order
+//   (a monotone queue): an entry lives in bucket
+//   bitLength(key XOR lastPopped), so each entry moves down at most 64
+//   times in total and push is O(1).
+// - An optional target stops the search as soon as it is settled.
+// - deltaStepping.h is the multi-threaded alternative for full
+//   single-source searches on large graphs; altRouting.h answers
+//   many point-to-point queries with landmark preprocessing.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "graph.h"
+
+using Distance = int64_t;
+constexpr Distance kInfinity = std::numeric_limits<Distance>::max();
+constexpr NodeId kNoNode = std::numeric_limits<NodeId>::max();
+
+// ===================================================================
+//                         PRIORITY QUEUES
+// ===================================================================
+
+/**
+ * @brief Implicit 4-ary min-heap of (distance, node) pairs.
+ */
+class QuadHeap {
+public:
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+    Distance topKey() const { return heap_[0].key; }
+    void clear() { heap_.clear(); }
+
+    void push(Distance key, NodeId node) {
+        heap_.push_back({key, node});
+        size_t i = heap_.size() - 1;
+        Entry e = heap_[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / 4;
+            if (heap_[parent].key <= e.key) break;
+            heap_[i] = heap_[parent];
+            i = parent;
+        }
+        heap_[i] = e;
+    }
+
+    std::pair<Distance, NodeId> pop() {
+        Entry top = heap_[0];
+        Entry last = heap_.back();
+        heap_.pop_back();
+        size_t n = heap_.size();
+        if (n > 0) {
+            size_t i = 0;
+            while (true) {
+                size_t first = 4 * i + 1;
+                if (first >= n) break;
+                size_t best = first;
+                size_t end = std::min(first + 4, n);
+                for (size_t c = first + 1; c < end; ++c)
+                    if (heap_[c].key < heap_[best].key) best = c;
+                if (heap_[best].key >= last.key) break;
+                heap_[i] = heap_[best];
+                i = best;
+            }
+            heap_[i] = last;
+        }
+        return {top.key, top.node};
+    }
+
+private:
+    struct Entry {
+        Distance key;
+        NodeId node;
+    };
+    std::vector<Entry> heap_;
+};
+
+/**
+ * @brief Monotone radix heap: pushed keys must be >= the last popped key.
+ */
+class RadixHeap {
+public:
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void push(Distance key, NodeId node) {
+        assert(key >= last_);
+        buckets_[bucketOf(key)].push_back({key, node});
+        ++size_;
+    }
+
+    std::pair<Distance, NodeId> pop() {
+        if (buckets_[0].empty()) {
+            // Refill bucket 0 from the first non-empty bucket: its minimum
+            // becomes the new reference, and every entry moves lower.
+            size_t b = 1;
+            while (buckets_[b].empty()) ++b;
+            Distance newLast = kInfinity;
+            for (const Entry& e : buckets_[b]) newLast = std::min(newLast, e.key);
+            last_ = newLast;
+            for (const Entry& e : buckets_[b]) buckets_[bucketOf(e.key)].push_back(e);
+            buckets_[b].clear();
+        }
+        Entry e = buckets_[0].back();
+        buckets_[0].pop_back();
+        --size_;
+        return {e.key, e.node};
+    }
+
+private:
+    struct Entry {
+        Distance key;
+        NodeId node;
+    };
+
+    size_t bucketOf(Distance key) const {
+        uint64_t diff = (uint64_t)key ^ (uint64_t)last_;
+        return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+    }
+
+    std::array<std::vector<Entry>, 65> buckets_;
+    Distance last_ = 0;
+    size_t size_ = 0;
+};
+
+// ===================================================================
+//                            DIJKSTRA
+// ===================================================================
+
+/**
+ * @brief Result of a single-source search.
+ */
+struct ShortestPaths {
+    std::vector<Distance> dist;  // kInfinity if unreachable
+    std::vector<NodeId> parent;  // kNoNode for the source / unreachable
+    size_t settled = 0;          // nodes popped with a final distance
+};
+
+/**
+ * @brief Dijkstra with lazy deletion on the given queue type.
+ *
+ * @param graph  CsrGraph or CsrView with non-negative weights.
+ * @param source Start node.
+ * @param target Stop once this node is settled (kNoNode = never).
+ */
+template <class Queue, class Graph>
+ShortestPaths dijkstra(const Graph& graph, NodeId source, NodeId target = kNoNode) {
+    size_t n = graph.nodeCount();
+    ShortestPaths sp;
+    sp.dist.assign(n, kInfinity);
+    sp.parent.assign(n, kNoNode);
+
+    Queue pq;
+    sp.dist[source] = 0;
+    pq.push(0, source);
+
+    while (!pq.empty()) {
+        auto [d, u] = pq.pop();
+        if (d > sp.dist[u]) continue;  // stale entry
+        ++sp.settled;
+        if (u == target) break;
+
+        for (uint64_t e = graph.offsets[u]; e < graph.offsets[u + 1]; ++e) {
+            NodeId v = graph.targets[e];
+            Distance nd = d + graph.weights[e];
+            if (nd < sp.dist[v]) {
+                sp.dist[v] = nd;
+                sp.parent[v] = u;
+                pq.push(nd, v);
+            }
+        }
+    }
+    return sp;
+}
+
+/**
+ * @brief Nodes on the path source -> target (empty if unreachable).
+ */
+inline std::vector<NodeId> extractPath(const ShortestPaths& sp, NodeId target) {
+    std::vector<NodeId> path;
+    if (sp.dist[target] == kInfinity) return path;
+    for (NodeId v = target; v != kNoNode; v = sp.parent[v]) path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+/**
+ * @brief True if every arc weight is >= 0 (Dijkstra's precondition).
+ */
+template <class Graph>
+bool hasNonNegativeWeights(const Graph& graph) {
+    for (EdgeWeight w : graph.weights)
+        if (w < 0) return false;
+    return true;
+}
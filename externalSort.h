@@ -0,0 +1,538 @@
+// ===================================================================
+//                  EXTERNAL-MEMORY MERGE SORT (INT FILES)
+// ===================================================================
+//
+// Sorts a binary file of native-endian ints that may be far larger
+// than RAM, using at most a fixed memory budget.
+//
+// Phase 1 - run formation:
+//   The input is read in budget-sized chunks; each chunk is sorted in
+//   memory (parallelMergeSort() or introQuickSort()) and written out
+//   as a sorted run. The next chunk is read by a helper thread while
+//   the current one is being sorted and written.
+//
+// Phase 2 - k-way merge:
+//   All runs are merged at once with a LOSER TREE (one comparison per
+//   tree level per output element, against the stored loser). If there
+//   are more runs than the budget allows buffers for, groups of runs
+//   are merged into longer runs first (multi-pass).
+//
+// Key Notes:
+// - I/O goes through a READER / WRITER THREAD PAIR: every run has two
+//   buffers, and while the merge consumes one the reader thread
+//   refills the other; full output buffers are handed to the writer
+//   thread. The merge loop itself never blocks on I/O unless the disk
+//   is slower than the merge.
+// - Merge buffers are page aligned (AlignedAllocator<int, 4096>), and
+//   they are as large as the budget allows, to keep reads long and
+//   sequential even with many runs.
+// - Run files are written next to the output and removed at the end.
+// - io_uring would replace the two threads with one submission queue;
+//   the thread pair needs nothing beyond POSIX.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "alignedAllocator.h"
+#include "mergeSort.h"  // parallelMergeSort()
+#include "quickSort.h"  // introQuickSort()
+#include "threadPool.h"
+
+/**
+ * @brief In-memory sort used for the runs.
+ */
+enum class RunSorter {
+    MergeSort,  // parallelMergeSort(): stable, parallel, needs a scratch buffer
+    QuickSort,  // introQuickSort(): in place, single-threaded
+};
+
+/**
+ * @brief Knobs of externalSort().
+ */
+struct ExternalSortConfig {
+    size_t memoryBytes = 256ull << 20;  // total for buffers in either phase
+    RunSorter sorter = RunSorter::MergeSort;
+    ThreadPool* pool = nullptr;         // threads for MergeSort (nullptr = 1)
+};
+
+/**
+ * @brief What externalSort() did and how long each phase took.
+ */
+struct ExternalSortStats {
+    uint64_t elements = 0;
+    size_t runs = 0;           // sorted runs after phase 1
+    size_t mergePasses = 0;    // passes over the data in phase 2
+    size_t maxFanIn = 0;       // most runs merged at once
+    double runPhaseNs = 0;     // read + sort + write
+    double sortNs = 0;         // in-memory sorting only (part of runPhaseNs)
+    double mergePhaseNs = 0;   // all merge passes
+
+    uint64_t bytes() const { return elements * sizeof(int); }
+    // MB/s of input data per pass (every pass reads and writes it all).
+    double runMBps() const { return runPhaseNs > 0 ? bytes() / runPhaseNs * 1e3 : 0; }
+    double sortMBps() const { return sortNs > 0 ? bytes() / sortNs * 1e3 : 0; }
+    double mergeMBps() const {
+        return mergePhaseNs > 0 ? bytes() * (double)std::max<size_t>(mergePasses, 1) / mergePhaseNs * 1e3 : 0;
+    }
+};
+
+namespace extsort_detail {
+
+constexpr size_t kIoAlign = 4096;
+constexpr size_t kMinBufferBytes = 256 << 10;
+constexpr size_t kMaxBufferBytes = 16 << 20;
+
+using IoBuffer = std::vector<int, AlignedAllocator<int, kIoAlign>>;
+
+/**
+ * @brief A sorted run: [offset, offset + count) elements of a run file.
+ */
+struct Run {
+    uint64_t offset = 0;
+    uint64_t count = 0;
+};
+
+// ------------------------------ raw I/O ------------------------------
+
+inline bool preadFully(int fd, void* buffer, size_t bytes, uint64_t offset) {
+    char* p = static_cast<char*>(buffer);
+    while (bytes > 0) {
+        ssize_t got = ::pread(fd, p, bytes, (off_t)offset);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        bytes -= (size_t)got;
+        offset += (uint64_t)got;
+    }
+    return true;
+}
+
+inline bool writeFully(int fd, const void* buffer, size_t bytes) {
+    const char* p = static_cast<const char*>(buffer);
+    while (bytes > 0) {
+        ssize_t put = ::write(fd, p, bytes);
+        if (put < 0 && errno == EINTR) continue;
+        if (put <= 0) return false;
+        p += put;
+        bytes -= (size_t)put;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads up to @p bytes sequentially; returns the bytes read.
+ */
+inline size_t readUpTo(int fd, void* buffer, size_t bytes) {
+    char* p = static_cast<char*>(buffer);
+    size_t total = 0;
+    while (total < bytes) {
+        ssize_t got = ::read(fd, p + total, bytes - total);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        total += (size_t)got;
+    }
+    return total;
+}
+
+/**
+ * @brief One background thread running I/O jobs in submission order.
+ *        Jobs signal completion through an atomic flag that wait()
+ *        blocks on.
+ */
+class IoThread {
+public:
+    IoThread() : thread_([this] { loop(); }) {}
+    ~IoThread() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    IoThread(const IoThread&) = delete;
+    IoThread& operator=(const IoThread&) = delete;
+
+    /**
+     * @brief Queues a job; it should set its own flag when done and
+     *        return false on an I/O error.
+     */
+    void submit(std::function<bool()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        cv_.notify_all();
+    }
+
+    void wait(const std::atomic<bool>& done) {
+        if (done.load(std::memory_order_acquire)) return;
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return done.load(std::memory_order_acquire); });
+    }
+
+    bool failed() const { return failed_.load(); }
+
+private:
+    void loop() {
+        while (true) {
+            std::function<bool()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return stop_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            if (!job()) failed_ = true;
+            // Lock before notifying so a waiter cannot miss the flag.
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<bool()>> jobs_;
+    std::atomic<bool> failed_{false};
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+/**
+ * @brief Loser tree over k sources: top() is the smallest current entry;
+ *        after it is consumed, replace() gives its source a new entry and
+ *        replays only that source's leaf-to-root path, keeping the loser
+ *        at every node.
+ *
+ *        An entry packs (value, source) into one uint64_t so that a
+ *        single unsigned compare orders by value and then by source
+ *        (which makes the merge stable), and min / max replace branches.
+ */
+class LoserTree {
+public:
+    static constexpr uint64_t kExhausted = std::numeric_limits<uint64_t>::max();
+
+    static uint64_t entry(int value, uint32_t source) {
+        return (uint64_t)((uint32_t)value ^ 0x80000000u) << 32 | source;
+    }
+    static int valueOf(uint64_t entry) { return (int)((uint32_t)(entry >> 32) ^ 0x80000000u); }
+    static uint32_t sourceOf(uint64_t entry) { return (uint32_t)entry; }
+
+    explicit LoserTree(const std::vector<uint64_t>& entries) : k_(entries.size()), tree_(std::max<size_t>(k_, 1)) {
+        // Bottom-up build: winners[] is scratch, tree_[node] keeps the loser.
+        std::vector<uint64_t> winners(2 * k_);
+        std::copy(entries.begin(), entries.end(), winners.begin() + k_);
+        for (size_t node = k_ - 1; node >= 1; --node) {
+            winners[node] = std::min(winners[2 * node], winners[2 * node + 1]);
+            tree_[node] = std::max(winners[2 * node], winners[2 * node + 1]);
+        }
+        tree_[0] = k_ > 1 ? winners[1] : k_ == 1 ? entries[0] : kExhausted;
+    }
+
+    uint64_t top() const { return tree_[0]; }
+
+    /**
+     * @brief Replaces the top entry with the next one from its source.
+     */
+    void replace(uint64_t next) {
+        for (size_t node = (sourceOf(tree_[0]) + k_) / 2; node >= 1; node /= 2) {
+            uint64_t other = tree_[node];
+            tree_[node] = std::max(next, other);
+            next = std::min(next, other);
+        }
+        tree_[0] = next;
+    }
+
+private:
+    size_t k_;
+    std::vector<uint64_t> tree_;
+};
+
+/**
+ * @brief Reads one run through two buffers that the reader thread
+ *        refills alternately.
+ */
+class RunInput {
+public:
+    RunInput(uint32_t source, int fd, Run run, size_t bufferElems, IoThread& reader)
+        : source_(source), fd_(fd), next_(run.offset), left_(run.count), reader_(reader) {
+        for (Slot& s : slots_) s.data.resize(bufferElems);
+        request(0);  // slot 1 starts empty; the first key() switches to 0
+    }
+
+    /**
+     * @brief Loser-tree entry of the next value (consuming it), or
+     *        LoserTree::kExhausted at the end of the run.
+     */
+    uint64_t next() {
+        if (pos_ == slots_[cur_].count && !switchBuffer()) return LoserTree::kExhausted;
+        return LoserTree::entry(slots_[cur_].data[pos_++], source_);
+    }
+
+private:
+    struct Slot {
+        IoBuffer data;
+        size_t count = 0;
+        std::atomic<bool> ready{true};
+    };
+
+    void request(int i) {
+        Slot& s = slots_[i];
+        size_t n = (size_t)std::min<uint64_t>(left_, s.data.size());
+        s.count = 0;
+        if (n == 0) return;
+        s.ready.store(false);
+        uint64_t offset = next_;
+        next_ += n;
+        left_ -= n;
+        reader_.submit([this, &s, n, offset] {
+            bool ok = preadFully(fd_, s.data.data(), n * sizeof(int), offset * sizeof(int));
+            s.count = ok ? n : 0;
+            s.ready.store(true, std::memory_order_release);
+            return ok;
+        });
+    }
+
+    bool switchBuffer() {
+        if (exhausted_) return false;
+        int done = cur_;
+        cur_ ^= 1;
+        pos_ = 0;
+        reader_.wait(slots_[cur_].ready);
+        if (slots_[cur_].count == 0) {
+            exhausted_ = true;
+            return false;
+        }
+        request(done);  // refill the drained buffer behind our back
+        return true;
+    }
+
+    uint32_t source_;
+    int fd_;
+    uint64_t next_, left_;  // next element offset to read, elements not yet requested
+    IoThread& reader_;
+    Slot slots_[2];
+    int cur_ = 1;
+    size_t pos_ = 0;
+    bool exhausted_ = false;
+};
+
+/**
+ * @brief Output stream: fills one buffer while the writer thread
+ *        writes the other.
+ */
+class RunOutput {
+public:
+    RunOutput(int fd, size_t bufferElems, IoThread& writer) : fd_(fd), writer_(writer) {
+        for (Slot& s : slots_) s.data.resize(bufferElems);
+    }
+    ~RunOutput() { finish(); }
+
+    void push(int x) {
+        Slot& s = slots_[cur_];
+        s.data[pos_++] = x;
+        if (pos_ == s.data.size()) flush();
+    }
+
+    /**
+     * @brief Writes what is buffered and waits for all writes.
+     */
+    void finish() {
+        flush();
+        for (Slot& s : slots_) writer_.wait(s.ready);
+    }
+
+private:
+    struct Slot {
+        IoBuffer data;
+        std::atomic<bool> ready{true};
+    };
+
+    void flush() {
+        if (pos_ == 0) return;
+        Slot& s = slots_[cur_];
+        s.ready.store(false);
+        size_t bytes = pos_ * sizeof(int);
+        writer_.submit([this, &s, bytes] {
+            bool ok = writeFully(fd_, s.data.data(), bytes);
+            s.ready.store(true, std::memory_order_release);
+            return ok;
+        });
+        cur_ ^= 1;
+        pos_ = 0;
+        writer_.wait(slots_[cur_].ready);  // its previous write must be done
+    }
+
+    int fd_;
+    IoThread& writer_;
+    Slot slots_[2];
+    int cur_ = 0;
+    size_t pos_ = 0;
+};
+
+/**
+ * @brief Merges @p runs of @p inFd into one run appended to @p outFd.
+ */
+inline void mergeGroup(int inFd, const std::vector<Run>& runs, int outFd, size_t bufferElems, IoThread& reader,
+                       IoThread& writer) {
+    if (runs.empty()) return;
+    std::vector<std::unique_ptr<RunInput>> inputs;
+    std::vector<uint64_t> entries;
+    for (const Run& r : runs) {
+        inputs.push_back(std::make_unique<RunInput>((uint32_t)inputs.size(), inFd, r, bufferElems, reader));
+        entries.push_back(inputs.back()->next());
+    }
+    RunOutput out(outFd, bufferElems, writer);
+
+    LoserTree tree(entries);
+    for (uint64_t top = tree.top(); top != LoserTree::kExhausted; top = tree.top()) {
+        out.push(LoserTree::valueOf(top));
+        tree.replace(inputs[LoserTree::sourceOf(top)]->next());
+    }
+    out.finish();
+}
+
+/**
+ * @brief Per-buffer size for merging k runs within the budget: two
+ *        buffers per run plus two for the output, page aligned.
+ */
+inline size_t bufferElemsFor(size_t k, size_t memoryBytes) {
+    size_t bytes = memoryBytes / (2 * (k + 1));
+    bytes = std::clamp(bytes / kIoAlign * kIoAlign, kMinBufferBytes, kMaxBufferBytes);
+    return bytes / sizeof(int);
+}
+
+inline int openForWrite(const std::string& path) { return ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644); }
+
+}  // namespace extsort_detail
+
+/**
+ * @brief Sorts the int file @p inputPath into @p outputPath.
+ *
+ * @return false (with a message on stderr) on an I/O error or if the
+ *         input size is not a multiple of sizeof(int).
+ */
+inline bool externalSort(const std::string& inputPath, const std::string& outputPath,
+                         const ExternalSortConfig& config = ExternalSortConfig(), ExternalSortStats* stats = nullptr) {
+    using namespace extsort_detail;
+    ExternalSortStats local;
+    ExternalSortStats& st = stats ? *stats : local;
+    st = ExternalSortStats();
+
+    int in = ::open(inputPath.c_str(), O_RDONLY);
+    if (in < 0) {
+        std::cerr << "Error: " << inputPath << " not found" << std::endl;
+        return false;
+    }
+    off_t inputBytes = ::lseek(in, 0, SEEK_END);
+    ::lseek(in, 0, SEEK_SET);
+    if (inputBytes < 0 || inputBytes % sizeof(int) != 0) {
+        std::cerr << "Error: " << inputPath << " is not a whole number of ints" << std::endl;
+        ::close(in);
+        return false;
+    }
+    ::posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+    st.elements = (uint64_t)inputBytes / sizeof(int);
+
+    // ---- phase 1: sorted runs ----
+    // Buffers alive at once: the chunk being sorted, the one being read
+    // ahead, and (merge sort only) the sort's scratch buffer.
+    size_t buffers = config.sorter == RunSorter::MergeSort ? 3 : 2;
+    size_t chunkElems = std::max<size_t>(1024, config.memoryBytes / buffers / sizeof(int));
+    chunkElems = std::min<size_t>(chunkElems, (size_t)std::numeric_limits<int>::max());
+
+    std::string runPaths[2] = {outputPath + ".run0", outputPath + ".run1"};
+    int runFd = openForWrite(runPaths[0]);
+    if (runFd < 0) {
+        std::cerr << "Error: cannot create " << runPaths[0] << std::endl;
+        ::close(in);
+        return false;
+    }
+
+    ThreadPool single(1);
+    ThreadPool& pool = config.pool ? *config.pool : single;
+    std::vector<Run> runs;
+    bool ok = true;
+    auto phaseStart = std::chrono::steady_clock::now();
+    {
+        std::vector<int> current(chunkElems), ahead(chunkElems);
+        auto readChunk = [&](std::vector<int>& buf) { return readUpTo(in, buf.data(), chunkElems * sizeof(int)) / sizeof(int); };
+        size_t count = readChunk(current);
+        uint64_t written = 0;
+        while (count > 0 && ok) {
+            auto next = std::async(std::launch::async, readChunk, std::ref(ahead));
+
+            auto sortStart = std::chrono::steady_clock::now();
+            if (config.sorter == RunSorter::MergeSort) {
+                current.resize(count);  // only the last chunk shrinks
+                parallelMergeSort(current, pool);
+            } else {
+                introQuickSort(current, 0, (int)count - 1);
+            }
+            st.sortNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - sortStart).count();
+
+            ok = writeFully(runFd, current.data(), count * sizeof(int));
+            runs.push_back({written, count});
+            written += count;
+
+            count = next.get();
+            std::swap(current, ahead);
+            if (current.size() < chunkElems) current.resize(chunkElems);
+        }
+    }
+    ::close(in);
+    st.runPhaseNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - phaseStart).count();
+    st.runs = runs.size();
+
+    // ---- phase 2: k-way merge, multi-pass if needed ----
+    size_t fanIn = std::max<size_t>(2, config.memoryBytes / (2 * kMinBufferBytes) - 1);
+    phaseStart = std::chrono::steady_clock::now();
+    {
+        IoThread reader, writer;
+        int src = 0;
+        while (ok && runs.size() > fanIn) {
+            int dstFd = openForWrite(runPaths[src ^ 1]);
+            ok = dstFd >= 0;
+            std::vector<Run> merged;
+            uint64_t written = 0;
+            for (size_t g = 0; ok && g < runs.size(); g += fanIn) {
+                std::vector<Run> group(runs.begin() + g, runs.begin() + std::min(runs.size(), g + fanIn));
+                mergeGroup(runFd, group, dstFd, bufferElemsFor(group.size(), config.memoryBytes), reader, writer);
+                uint64_t count = 0;
+                for (const Run& r : group) count += r.count;
+                merged.push_back({written, count});
+                written += count;
+                st.maxFanIn = std::max(st.maxFanIn, group.size());
+            }
+            ::close(runFd);
+            runFd = dstFd;
+            src ^= 1;
+            runs.swap(merged);
+            ++st.mergePasses;
+        }
+
+        int outFd = ok ? openForWrite(outputPath) : -1;
+        if (outFd < 0) {
+            if (ok) std::cerr << "Error: cannot create " << outputPath << std::endl;
+            ok = false;
+        } else {
+            mergeGroup(runFd, runs, outFd, bufferElemsFor(runs.size(), config.memoryBytes), reader, writer);
+            ++st.mergePasses;
+            st.maxFanIn = std::max(st.maxFanIn, runs.size());
+            ::close(outFd);
+        }
+        ok = ok && !reader.failed() && !writer.failed();
+    }
+    if (runFd >= 0) ::close(runFd);
+    st.mergePhaseNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - phaseStart).count();
+
+    for (const std::string& p : runPaths) std::remove(p.c_str());
+    if (!ok) std::cerr << "Error: I/O failure while sorting " << inputPath << std::endl;
+    return ok;
+}
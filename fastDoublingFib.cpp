@@ -0,0 +1,99 @@
+// ===================================================================
+//                 FAST DOUBLING FIBONACCI BENCHMARK
+// ===================================================================
+//
+// This program benchmarks EXACT Fibonacci numbers computed by fast
+// doubling on big integers, next to the existing recursive and DP
+// versions, and appends everything to benchmark_results.csv.
+//
+// Key Notes:
+// - Fast doubling needs O(log n) steps, each a couple of big-integer
+//   squarings (schoolbook for small, Karatsuba for large numbers).
+// - fibonacciDP() is timed on the same n for comparison, but its
+//   long long result is only correct up to n=92.
+// - fibonacciBigDP() is the exact O(n) loop on big integers; it is
+//   only run up to n=10^5 because it is O(n^2) in bit operations.
+// - fibRecursive() is only run up to n=30 (exponential time).
+// - Every result is checked: against fibonacciDP() for n<=92, against
+//   fibonacciBigDP() where that is run, and modulo two primes against
+//   an independent word-sized fast doubling for every n.
+//
+// Build: g++ -O2 -march=native fastDoublingFib.cpp -o fastDoublingFib
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"  // Shared timing harness + CSV writer
+#include "fibonacci.h"  // fibRecursive(), fibonacciDP(), fibonacciFastDoubling()
+using namespace std;
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main() {
+    vector<int> test_n = {10, 30, 50, 90, 100, 500, 1000, 5000, 10000, 100000, 1000000, 10000000};
+
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    bench::Config cfg;
+    cfg.samples = 10;
+    cfg.maxTotalNs = 3e9;
+
+    cout << "--- Exact Fibonacci: Fast Doubling vs. DP vs. Recursion ---\n" << endl;
+
+    for (int n : test_n) {
+        // ---- correctness ----
+        BigUnsigned exact = fibonacciFastDoubling(n);
+        const uint64_t primes[] = {1000000007ull, 998244353ull};
+        for (uint64_t p : primes) {
+            if (exact.modSmall(p) != fibonacciMod(n, p)) {
+                cerr << "Error: fast doubling F(" << n << ") fails the mod " << p << " check" << endl;
+                return 1;
+            }
+        }
+        if (n <= 92 && exact.toString() != to_string(fibonacciDP(n))) {
+            cerr << "Error: fast doubling F(" << n << ") != fibonacciDP" << endl;
+            return 1;
+        }
+        if (n <= 100000 && exact != fibonacciBigDP(n)) {
+            cerr << "Error: fast doubling F(" << n << ") != fibonacciBigDP" << endl;
+            return 1;
+        }
+
+        cout << "F(" << n << "): " << exact.bitLength() << " bits, last digits ..."
+             << exact.lowDigits() << endl;
+
+        // ---- timing ----
+        vector<bench::Stats> results;
+        results.push_back(bench::measure("FastDoublingFibonacci", n, [&] {
+            bench::doNotOptimize(fibonacciFastDoubling(n));
+        }, cfg));
+        if (n <= 100000)
+            results.push_back(bench::measure("BigDP Fibonacci", n, [&] {
+                bench::doNotOptimize(fibonacciBigDP(n));
+            }, cfg));
+        results.push_back(bench::measure("DP Fibonacci", n, [&] {
+            bench::doNotOptimize(fibonacciDP(n));
+        }, cfg));
+        if (n <= 30)
+            results.push_back(bench::measure("RecursiveFibonacci", n, [&] {
+                bench::doNotOptimize(fibRecursive(n));
+            }, cfg));
+
+        for (const bench::Stats& stats : results) {
+            cout << "  " << setw(22) << left << stats.algorithm << right;
+            bench::printStats(stats);
+            csv.write(stats);
+        }
+        cout << endl;
+    }
+
+    cout << "Results appended to " << csv.path() << endl;
+
+    return 0;
+}
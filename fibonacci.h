@@ -0,0 +1,167 @@
+// ===================================================================
+//                       FIBONACCI ALGORITHMS
+// ===================================================================
+//
+// All Fibonacci implementations in one place, so the benchmark
+// programs can compare them against each other.
+//
+// Key Notes:
+// - fibRecursive() and fibonacciDP() return long long, which can only
+//   hold F(n) up to n = 92. Past that they overflow, so they are only
+//   useful for timing, not for values.
+// - fibonacciBigDP() is the same O(n) bottom-up loop on big integers,
+//   keeping only the last two values: exact, but every addition
+//   touches the whole number, so it is O(n^2) bit operations.
+// - fibonacciFastDoubling() is exact and needs only O(log n) steps.
+//   Each step doubles the index with two squarings (the identities
+//   GMP uses), and the last step needs a single multiplication:
+//       F(2k+1) = 4F(k)^2 - F(k-1)^2 + 2(-1)^k
+//       F(2k-1) = F(k)^2 + F(k-1)^2
+//       F(2k)   = F(2k+1) - F(2k-1)
+//   With Karatsuba squaring the total cost is dominated by the last
+//   few steps, about O(M(n)) for an n-bit multiplication M.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "bigInteger.h"
+
+// ===================================================================
+//                NAIVE RECURSIVE FIBONACCI
+// ===================================================================
+
+/**
+ * @brief Naive recursive Fibonacci implementation.
+ *
+ * @param n The Fibonacci index.
+ * @return The nth Fibonacci number.
+ *
+ * Time Complexity: O(2^n)
+ * Space Complexity: O(n) due to recursion depth.
+ */
+inline long long fibRecursive(int n) {
+    if (n <= 1) return n;
+    return fibRecursive(n - 1) + fibRecursive(n - 2);
+}
+
+// ===================================================================
+//                    DYNAMIC PROGRAMMING FIBONACCI
+// ===================================================================
+
+/**
+ * @brief Computes Fibonacci using bottom-up dynamic programming.
+ *
+ * @param n The input Fibonacci index.
+ * @return long long The nth Fibonacci number (for benchmarking, only time matters).
+ */
+inline long long fibonacciDP(int n) {
+    if (n <= 1) return n;
+
+    std::vector<long long> fib(n + 1);
+    fib[0] = 0;
+    fib[1] = 1;
+
+    for (int i = 2; i <= n; i++) {
+        fib[i] = fib[i - 1] + fib[i - 2];
+    }
+
+    return fib[n];
+}
+
+/**
+ * @brief Exact bottom-up Fibonacci on big integers (two registers).
+ *
+ * @param n The input Fibonacci index.
+ * @return The exact nth Fibonacci number.
+ *
+ * Time Complexity: O(n^2) bit operations (n additions of O(n) bits).
+ */
+inline BigUnsigned fibonacciBigDP(int n) {
+    BigUnsigned prev(0), cur(1);
+    if (n == 0) return prev;
+    for (int i = 2; i <= n; i++) {
+        BigUnsigned next = prev + cur;
+        prev = std::move(cur);
+        cur = std::move(next);
+    }
+    return cur;
+}
+
+// ===================================================================
+//                    FAST DOUBLING FIBONACCI
+// ===================================================================
+
+/**
+ * @brief Exact Fibonacci by fast doubling on big integers.
+ *
+ * @param n The input Fibonacci index.
+ * @return The exact nth Fibonacci number.
+ *
+ * Time Complexity: O(log n) doubling steps of two squarings each.
+ */
+inline BigUnsigned fibonacciFastDoubling(unsigned long long n) {
+    if (n == 0) return BigUnsigned(0);
+    if (n <= 2) return BigUnsigned(1);
+
+    // Invariant: fk = F(k), fk1 = F(k-1); start at k = 1.
+    BigUnsigned fk(1), fk1(0);
+    unsigned long long k = 1;
+    int top = 63 - __builtin_clzll(n);
+
+    for (int bit = top - 1; bit >= 1; --bit) {
+        BigUnsigned a = fk.square();   // F(k)^2
+        BigUnsigned b = fk1.square();  // F(k-1)^2
+
+        // F(2k+1) = 4F(k)^2 - F(k-1)^2 + 2(-1)^k
+        BigUnsigned f2k1 = (a << 2) - b;
+        if (k % 2 == 0) f2k1.addSmall(2);
+        else f2k1.subSmall(2);
+        BigUnsigned f2km1 = a + b;         // F(2k-1)
+        BigUnsigned f2k = f2k1 - f2km1;    // F(2k)
+
+        if ((n >> bit) & 1) {
+            fk = std::move(f2k1);
+            fk1 = std::move(f2k);
+            k = 2 * k + 1;
+        } else {
+            fk = std::move(f2k);
+            fk1 = std::move(f2km1);
+            k = 2 * k;
+        }
+    }
+
+    // Last step: one product instead of two squares.
+    BigUnsigned twoFk = fk << 1;
+    if (n & 1) {
+        // F(2k+1) = (2F(k) + F(k-1)) (2F(k) - F(k-1)) + 2(-1)^k
+        BigUnsigned r = (twoFk + fk1) * (twoFk - fk1);
+        if (k % 2 == 0) r.addSmall(2);
+        else r.subSmall(2);
+        return r;
+    }
+    // F(2k) = F(k) (F(k) + 2F(k-1))
+    return fk * (fk + (fk1 << 1));
+}
+
+/**
+ * @brief F(n) mod m by fast doubling on machine words (for checks).
+ */
+inline uint64_t fibonacciMod(unsigned long long n, uint64_t m) {
+    using Wide = unsigned __int128;
+    uint64_t a = 0, b = 1 % m;  // F(k), F(k+1) with k = 0
+    for (int bit = 63; bit >= 0; --bit) {
+        // F(2k) = F(k)(2F(k+1) - F(k)), F(2k+1) = F(k)^2 + F(k+1)^2
+        uint64_t c = (uint64_t)((Wide)a * ((2 * (Wide)b + m - a) % m) % m);
+        uint64_t d = (uint64_t)(((Wide)a * a + (Wide)b * b) % m);
+        if ((n >> bit) & 1) {
+            a = d;
+            b = (c + d) % m;
+        } else {
+            a = c;
+            b = d;
+        }
+    }
+    return a;
+}
@@ -0,0 +1,212 @@
+// ===================================================================
+//                    GRAPH LOADING AND CSR STORAGE
+// ===================================================================
+//
+// Shared graph representation for the C++ shortest-path programs.
+// It reads the same text files as the Python scripts:
+//
+//   graph1.txt (dijkstra.py)       graph.txt (bellmanFord.py)
+//   ------------------------       --------------------------
+//   m                              n m
+//   u v w      (m lines)           u v w      (m lines)
+//
+// Key Notes:
+// - Node names are arbitrary whitespace-free strings. They are
+//   interned into dense ids 0..n-1 in order of first appearance, and
+//   names[id] maps back.
+// - The adjacency is stored in compressed-sparse-row (CSR) form: the
+//   out-edges of u are targets/weights[offsets[u] .. offsets[u+1]).
+//   Two flat arrays instead of a vector per node means one allocation
+//   and sequential memory for every neighbour scan.
+// - graph1.txt is undirected (every line becomes two arcs), graph.txt
+//   is directed (it already lists both directions).
+// - graphLoader.h builds on this with a parallel mmap parser and
+//   binary CSR snapshots for large files.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+
+using NodeId = uint32_t;
+using EdgeWeight = int32_t;
+
+struct Edge {
+    NodeId from, to;
+    EdgeWeight weight;
+};
+
+/**
+ * @brief True if a weight read from a file fits in EdgeWeight. Both
+ *        text parsers reject the edge otherwise instead of wrapping it.
+ */
+inline bool weightFits(long long w) {
+    return w >= std::numeric_limits<EdgeWeight>::min() && w <= std::numeric_limits<EdgeWeight>::max();
+}
+
+/**
+ * @brief Directed graph in compressed-sparse-row form.
+ */
+struct CsrGraph {
+    std::vector<uint64_t> offsets;   // n + 1 entries
+    std::vector<NodeId> targets;     // one per arc
+    std::vector<EdgeWeight> weights; // one per arc
+    std::vector<std::string> names;  // id -> name
+
+    size_t nodeCount() const { return names.size(); }
+    size_t arcCount() const { return targets.size(); }
+
+    /**
+     * @brief Id of a node name, or -1 if the graph has no such node.
+     */
+    long long idOf(const std::string& name) const {
+        for (size_t i = 0; i < names.size(); ++i)
+            if (names[i] == name) return (long long)i;
+        return -1;
+    }
+};
+
+/**
+ * @brief Maps node names to dense ids in order of first appearance.
+ */
+class NameInterner {
+public:
+    NodeId intern(const std::string& name) {
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+        NodeId id = (NodeId)names_.size();
+        ids_.emplace(name, id);
+        names_.push_back(name);
+        return id;
+    }
+
+    std::vector<std::string> takeNames() { return std::move(names_); }
+    size_t size() const { return names_.size(); }
+
+private:
+    std::unordered_map<std::string, NodeId> ids_;
+    std::vector<std::string> names_;
+};
+
+/**
+ * @brief Builds the CSR arrays from an edge list (counting sort by
+ *        source; the order of a node's out-edges follows the input).
+ *
+ * @param undirected Add the reverse arc of every edge as well.
+ */
+inline CsrGraph buildCsr(const std::vector<Edge>& edges, std::vector<std::string> names, bool undirected) {
+    CsrGraph g;
+    size_t n = names.size();
+    g.names = std::move(names);
+    g.offsets.assign(n + 1, 0);
+
+    for (const Edge& e : edges) {
+        g.offsets[e.from + 1]++;
+        if (undirected) g.offsets[e.to + 1]++;
+    }
+    for (size_t i = 0; i < n; ++i) g.offsets[i + 1] += g.offsets[i];
+
+    g.targets.resize(g.offsets[n]);
+    g.weights.resize(g.offsets[n]);
+    std::vector<uint64_t> fill(g.offsets.begin(), g.offsets.end() - 1);
+    for (const Edge& e : edges) {
+        uint64_t pos = fill[e.from]++;
+        g.targets[pos] = e.to;
+        g.weights[pos] = e.weight;
+        if (undirected) {
+            pos = fill[e.to]++;
+            g.targets[pos] = e.from;
+            g.weights[pos] = e.weight;
+        }
+    }
+    return g;
+}
+
+/**
+ * @brief Which of the two text formats a file uses.
+ */
+enum class EdgeListFormat {
+    CountThenEdges,       // graph1.txt: "m", undirected
+    NodesEdgesThenEdges,  // graph.txt:  "n m", directed
+};
+
+/**
+ * @brief Reads an edge-list text file into an edge array.
+ *
+ * @param path   File to read.
+ * @param format Header layout (see EdgeListFormat).
+ * @param edges  Output edges, with interned node ids.
+ * @param names  Output id -> name table.
+ * @return false (with a message on stderr) if the file cannot be read.
+ */
+inline bool readEdgeListText(const std::string& path, EdgeListFormat format, std::vector<Edge>& edges,
+                             std::vector<std::string>& names) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Error: " << path << " not found" << std::endl;
+        return false;
+    }
+
+    long long declaredNodes = -1, m = 0;
+    if (format == EdgeListFormat::NodesEdgesThenEdges) in >> declaredNodes;
+    if (!(in >> m) || m < 0) {
+        std::cerr << "Error reading file: bad header in " << path << std::endl;
+        return false;
+    }
+
+    NameInterner interner;
+    edges.clear();
+    edges.reserve(m);
+    std::string u, v;
+    long long w;
+    for (long long i = 0; i < m; ++i) {
+        if (!(in >> u >> v >> w)) {
+            std::cerr << "Error reading file: " << path << " ends after " << i << " of " << m
+                      << " edges" << std::endl;
+            return false;
+        }
+        if (!weightFits(w)) {
+            std::cerr << "Error reading file: " << path << " edge " << i + 1 << " has weight " << w
+                      << " outside the 32-bit range" << std::endl;
+            return false;
+        }
+        edges.push_back({interner.intern(u), interner.intern(v), (EdgeWeight)w});
+    }
+    names = interner.takeNames();
+
+    // Nodes without edges only exist through the declared count.
+    for (long long i = (long long)names.size(); i < declaredNodes; ++i)
+        names.push_back("#" + std::to_string(i));
+    return true;
+}
+
+/**
+ * @brief Reads a graph text file straight into CSR form.
+ */
+inline bool loadGraphText(const std::string& path, EdgeListFormat format, CsrGraph& graph) {
+    std::vector<Edge> edges;
+    std::vector<std::string> names;
+    if (!readEdgeListText(path, format, edges, names)) return false;
+    graph = buildCsr(edges, std::move(names), format == EdgeListFormat::CountThenEdges);
+    return true;
+}
+
+/**
+ * @brief Writes a random connected-ish graph in the graph1.txt format
+ *        (names "v0", "v1", ...), for scaling tests.
+ */
+inline bool writeRandomGraphText(const std::string& path, size_t nodes, size_t edges, int maxWeight,
+                                 uint64_t seed) {
+    std::ofstream out(path);
+    if (!out) return false;
+    std::mt19937_64 gen(seed);
+    out << edges << "\n";
+    for (size_t i = 0; i < edges; ++i) {
+        // The first nodes-1 edges form a random spanning tree.
+        size_t u = i + 1 < nodes ? i + 1 : gen() % nodes;
+        size_t v = i + 1 < nodes ? gen() % (i + 1) : gen() % nodes;
+        out << 'v' << u << " v" << v << " " << 1 + gen() % maxWeight << "\n";
+    }
+    return (bool)out;
+}
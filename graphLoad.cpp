@@ -0,0 +1,155 @@
+// ===================================================================
+//                   GRAPH LOADING BENCHMARK PROGRAM
+// ===================================================================
+//
+// How long it takes to get a graph into memory, from text and from a
+// binary snapshot (see graphLoader.h).
+//
+// Usage:
+//   ./graphLoad                  generate a 4M-edge graph1.txt-style file
+//                                in the temp directory and load that
+//   ./graphLoad FILE [directed]  load FILE (graph1.txt format, or the
+//                                graph.txt format with "directed")
+//   ./graphLoad --edges M        generated file with M edges
+//
+// Key Notes:
+// - Text paths: the istream reader from graph.h, and the mmap parser on
+//   1 thread and on all threads. Each includes building the CSR.
+// - Snapshot paths: writing it, mapping it (zero-copy, nothing is read
+//   yet) and mapping it plus one pass over every arc, which is what a
+//   search would pay on first touch.
+// - The file is in the page cache for every run, so these are
+//   parse / copy costs, not disk speed.
+// - All loaders must produce the same CSR graph.
+//
+// Build: g++ -O2 -pthread graphLoad.cpp -o graphLoad
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"    // Shared timing harness + CSV writer
+#include "graphLoader.h"  // readEdgeListMapped(), snapshots
+using namespace std;
+
+/**
+ * @brief True if a CsrGraph and a CsrView hold the same graph.
+ */
+bool sameGraph(const CsrGraph& a, const CsrView& b) {
+    if (a.nodeCount() != b.nodeCount() || a.arcCount() != b.arcCount()) return false;
+    if (!equal(a.offsets.begin(), a.offsets.end(), b.offsets.begin())) return false;
+    if (!equal(a.targets.begin(), a.targets.end(), b.targets.begin())) return false;
+    if (!equal(a.weights.begin(), a.weights.end(), b.weights.begin())) return false;
+    for (size_t i = 0; i < a.nodeCount(); ++i)
+        if (a.names[i] != b.names[i]) return false;
+    return true;
+}
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    string file_name;
+    EdgeListFormat format = EdgeListFormat::CountThenEdges;
+    size_t generated_edges = 4000000;
+
+    if (argc == 3 && string(argv[1]) == "--edges") {
+        generated_edges = stoull(argv[2]);
+    } else if (argc > 1) {
+        file_name = argv[1];
+        if (argc > 2 && string(argv[2]) == "directed") format = EdgeListFormat::NodesEdgesThenEdges;
+    }
+
+    if (file_name.empty()) {
+        file_name = (filesystem::temp_directory_path() / ("graph_load_" + to_string(generated_edges) + ".txt")).string();
+        if (!filesystem::exists(file_name)) {
+            cout << "Generating " << file_name << " ..." << endl;
+            if (!writeRandomGraphText(file_name, generated_edges / 4, generated_edges, 100, 42)) {
+                cerr << "Error: could not write " << file_name << endl;
+                return 1;
+            }
+        }
+    }
+
+    size_t max_threads = max(1u, thread::hardware_concurrency());
+    ThreadPool pool(max_threads);
+    bool undirected = format == EdgeListFormat::CountThenEdges;
+    double file_mb = filesystem::file_size(file_name) / 1e6;
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 5;
+    cfg.maxTotalNs = 2e10;
+
+    // ---- text loaders ----
+    CsrGraph reference;
+    if (!loadGraphText(file_name, format, reference)) return 1;
+    long long m = (long long)reference.arcCount();
+    cout << file_name << ": " << fixed << setprecision(1) << file_mb << " MB, " << reference.nodeCount()
+         << " nodes, " << m << " arcs" << defaultfloat << endl;
+
+    vector<bench::Stats> results;
+    results.push_back(bench::measure("GraphLoad_istream", m, [&] {
+        CsrGraph g;
+        loadGraphText(file_name, format, g);
+        bench::doNotOptimize(g.offsets.data());
+    }, cfg));
+
+    CsrGraph parsed;
+    for (size_t t : {(size_t)1, max_threads}) {
+        ThreadPool* p = t == 1 ? nullptr : &pool;
+        results.push_back(bench::measure("GraphLoad_mmap_t" + to_string(t), m, [&] {
+            vector<Edge> edges;
+            vector<string> names;
+            readEdgeListMapped(file_name, format, edges, names, p);
+            parsed = buildCsr(edges, move(names), undirected);
+        }, cfg));
+        if (max_threads == 1) break;
+    }
+
+    // ---- snapshot ----
+    LoadedGraph in_memory;
+    in_memory.adopt(parsed);
+    string snapshot = file_name + ".csr";
+    results.push_back(bench::measure("GraphLoad_snapshot_write", m, [&] {
+        writeCsrSnapshot(snapshot, in_memory.view(), format, file_name);
+    }, cfg));
+
+    LoadedGraph mapped;
+    results.push_back(bench::measure("GraphLoad_snapshot_open", m, [&] {
+        mapped.openSnapshot(snapshot);
+        bench::doNotOptimize(mapped.view().offsets.data());
+    }, cfg));
+    results.push_back(bench::measure("GraphLoad_snapshot_scan", m, [&] {
+        LoadedGraph g;
+        g.openSnapshot(snapshot);
+        long long sum = 0;
+        for (EdgeWeight w : g.view().weights) sum += w;
+        for (NodeId v : g.view().targets) sum += v;
+        bench::doNotOptimize(sum);
+    }, cfg));
+
+    // ---- verification ----
+    if (!sameGraph(reference, in_memory.view()) || !mapped.isMapped() || !sameGraph(reference, mapped.view())) {
+        cerr << "Error: loaders disagree on the graph" << endl;
+        return 1;
+    }
+
+    // ---- output ----
+    double base = results[0].medianNs;
+    cout << "\n" << left << setw(28) << "Loader" << right << setw(12) << "Median ms" << setw(12) << "MB/s"
+         << setw(12) << "Speedup" << endl;
+    for (const bench::Stats& s : results) {
+        cout << left << setw(28) << s.algorithm << right << fixed << setprecision(3) << setw(12) << s.medianNs / 1e6
+             << setprecision(1) << setw(12) << file_mb / (s.medianNs / 1e9) << setw(11) << base / s.medianNs << "x"
+             << defaultfloat << endl;
+    }
+    cout << "(MB/s is relative to the text file size for every row)" << endl;
+
+    bench::ResultWriter csv;
+    if (csv.isOpen()) {
+        for (const bench::Stats& s : results) csv.write(s);
+        cout << "Results appended to " << csv.path() << endl;
+    }
+    return 0;
+}
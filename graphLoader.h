@@ -0,0 +1,609 @@
+// ===================================================================
+//              FAST GRAPH LOADING: MMAP PARSER + CSR SNAPSHOTS
+// ===================================================================
+//
+// For edge lists too big to re-parse on every run (see graph.h for the
+// two text formats):
+//
+//   1. readEdgeListMapped() maps the text file and parses it in
+//      parallel chunks, each cut at a newline.
+//   2. writeCsrSnapshot() stores the finished CSR graph, names included,
+//      in a versioned binary file.
+//   3. LoadedGraph::openSnapshot() maps that file and points a CsrView
+//      straight into it: zero copies, so startup costs one sequential
+//      validating pass over the offsets and targets instead of a parse.
+//
+// loadGraphCached() ties the three together behind "FILE.csr".
+//
+// Key Notes:
+// - The parallel parser expects ONE EDGE PER LINE (as every file in
+//   this repository has); within that it accepts exactly what the
+//   istream reader accepts (including the weightFits() range check)
+//   and produces the same ids and edge order.
+// - Each chunk interns names into chunk-local ids. The chunk tables are
+//   merged in file order, so global ids still follow first appearance,
+//   and only one hash lookup per distinct name per chunk is serial.
+// - A snapshot remembers the size and mtime of its source file and is
+//   rebuilt automatically when the text changes. A wrong magic, version
+//   or byte order, a section past the end of the file, non-monotone
+//   offsets or an out-of-range target also just mean "rebuild", never
+//   a crash.
+// - Snapshot sections are 64-byte aligned, so the mapped arrays can be
+//   used in place.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "graph.h"
+#include "mappedFile.h"  // MappedFile, ArrayView
+#include "threadPool.h"
+
+// ===================================================================
+//                     READ-ONLY VIEWS OF A CSR GRAPH
+// ===================================================================
+
+/**
+ * @brief Node names packed into one character block:
+ *        name i = chars[offsets[i] .. offsets[i+1]).
+ */
+class NameTable {
+public:
+    NameTable() = default;
+    NameTable(ArrayView<uint64_t> offsets, const char* chars) : offsets_(offsets), chars_(chars) {}
+
+    size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    std::string_view operator[](size_t i) const {
+        return {chars_ + offsets_[i], (size_t)(offsets_[i + 1] - offsets_[i])};
+    }
+    std::string_view front() const { return (*this)[0]; }
+    std::string_view back() const { return (*this)[size() - 1]; }
+
+private:
+    ArrayView<uint64_t> offsets_;
+    const char* chars_ = nullptr;
+};
+
+/**
+ * @brief Same layout and member names as CsrGraph, but non-owning, so
+ *        the graph algorithms accept either.
+ */
+struct CsrView {
+    ArrayView<uint64_t> offsets;    // n + 1 entries
+    ArrayView<NodeId> targets;      // one per arc
+    ArrayView<EdgeWeight> weights;  // one per arc
+    NameTable names;                // id -> name
+
+    size_t nodeCount() const { return names.size(); }
+    size_t arcCount() const { return targets.size(); }
+
+    /**
+     * @brief Id of a node name, or -1 if the graph has no such node.
+     */
+    long long idOf(std::string_view name) const {
+        for (size_t i = 0; i < names.size(); ++i)
+            if (names[i] == name) return (long long)i;
+        return -1;
+    }
+};
+
+// ===================================================================
+//                         SNAPSHOT FORMAT
+// ===================================================================
+
+constexpr uint32_t kSnapshotVersion = 1;
+
+/**
+ * @brief Fixed header at the start of a snapshot file. The *At fields
+ *        are byte offsets of the sections from the start of the file.
+ */
+struct SnapshotHeader {
+    char magic[8];         // "CSRSNAP\0"
+    uint32_t version;      // kSnapshotVersion
+    uint32_t byteOrder;    // 0x01020304 as stored by the writer
+    uint64_t nodeCount;
+    uint64_t arcCount;
+    uint64_t nameBytes;
+    uint64_t sourceSize;   // size of the text file it was built from
+    int64_t sourceMtime;   // its modification time (filesystem clock ticks)
+    uint32_t format;       // EdgeListFormat of the source
+    uint32_t reserved;
+    uint64_t offsetsAt, targetsAt, weightsAt, nameOffsetsAt, namesAt;
+};
+
+namespace loader_detail {
+
+constexpr char kMagic[8] = {'C', 'S', 'R', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr size_t kSectionAlign = 64;
+constexpr size_t kMinChunkBytes = 1 << 20;
+
+inline uint64_t alignUp(uint64_t x) { return (x + kSectionAlign - 1) / kSectionAlign * kSectionAlign; }
+
+/**
+ * @brief Size and modification time of a file, to tell whether a
+ *        snapshot is still up to date.
+ */
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+
+inline bool stampOf(const std::string& path, SourceStamp& stamp) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    stamp.size = size;
+    stamp.mtime = (int64_t)mtime.time_since_epoch().count();
+    return true;
+}
+
+// ---------------------------- tokenizer ----------------------------
+
+inline bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+/**
+ * @brief Next whitespace-separated token in [p, end), advancing p.
+ *        Empty if only whitespace is left.
+ */
+inline std::string_view nextToken(const char*& p, const char* end) {
+    while (p < end && isSpace(*p)) ++p;
+    const char* start = p;
+    while (p < end && !isSpace(*p)) ++p;
+    return {start, (size_t)(p - start)};
+}
+
+/**
+ * @brief Parses a whole token as a (possibly signed) integer.
+ */
+inline bool parseInteger(std::string_view token, long long& value) {
+    if (!token.empty() && token.front() == '+') token.remove_prefix(1);
+    if (token.empty()) return false;
+    auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    return ec == std::errc() && ptr == token.data() + token.size();
+}
+
+/**
+ * @brief Open-addressing map from name to dense id, in order of first
+ *        insertion. Keys are views into the mapped file, so nothing is
+ *        copied or allocated per name (unlike std::unordered_map).
+ */
+class NameMap {
+public:
+    NameMap() : slots_(1024) {}
+
+    /**
+     * @brief Id of @p name, inserting it with the next free id if new.
+     */
+    NodeId intern(std::string_view name) {
+        if ((names_.size() + 1) * 2 > slots_.size()) grow();
+        uint64_t h = hash(name);
+        size_t mask = slots_.size() - 1;
+        for (size_t i = h & mask;; i = (i + 1) & mask) {
+            Slot& slot = slots_[i];
+            if (slot.id == kEmpty) {
+                slot.hash = h;
+                slot.id = (NodeId)names_.size();
+                if (name.size() <= sizeof slot.inlined) {
+                    slot.length = (uint8_t)name.size();
+                    std::memcpy(slot.inlined, name.data(), name.size());
+                } else {
+                    slot.length = kLongName;
+                }
+                names_.push_back(name);
+                return slot.id;
+            }
+            if (slot.hash == h && matches(slot, name)) return slot.id;
+        }
+    }
+
+    const std::vector<std::string_view>& names() const { return names_; }
+
+private:
+    static constexpr NodeId kEmpty = std::numeric_limits<NodeId>::max();
+    static constexpr uint8_t kLongName = 0xFF;  // name lives only in names_
+
+    // Short names are copied into the slot, so a hit touches one cache
+    // line instead of also reading the name back from the text file.
+    struct alignas(32) Slot {
+        uint64_t hash = 0;
+        NodeId id = kEmpty;
+        uint8_t length = 0;
+        char inlined[19];
+    };
+
+    bool matches(const Slot& slot, std::string_view name) const {
+        if (name.size() <= sizeof slot.inlined)
+            return slot.length == name.size() && std::memcmp(slot.inlined, name.data(), name.size()) == 0;
+        return names_[slot.id] == name;
+    }
+
+    static uint64_t hash(std::string_view s) {
+        uint64_t h = 0x9E3779B97F4A7C15ull ^ s.size();
+        for (unsigned char c : s) h = (h ^ c) * 0x100000001B3ull;  // FNV-1a style
+        return h ^ (h >> 29);
+    }
+
+    void grow() {
+        std::vector<Slot> bigger(slots_.size() * 2);
+        size_t mask = bigger.size() - 1;
+        for (const Slot& slot : slots_) {
+            if (slot.id == kEmpty) continue;
+            size_t i = slot.hash & mask;
+            while (bigger[i].id != kEmpty) i = (i + 1) & mask;
+            bigger[i] = slot;
+        }
+        slots_.swap(bigger);
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<std::string_view> names_;
+};
+
+/**
+ * @brief Edges of one chunk, with ids local to the chunk.
+ */
+struct ParsedChunk {
+    std::vector<Edge> edges;
+    NameMap ids;           // local id -> name, first appearance order
+    bool complete = true;  // false if parsing stopped at a bad edge
+    long long badWeight = 0;  // the out-of-range weight it stopped at, if any
+};
+
+inline void parseChunk(const char* p, const char* end, ParsedChunk& chunk) {
+    chunk.edges.reserve((size_t)(end - p) / 16);
+    while (true) {
+        std::string_view u = nextToken(p, end);
+        if (u.empty()) return;
+        std::string_view v = nextToken(p, end);
+        long long w;
+        if (v.empty() || !parseInteger(nextToken(p, end), w)) {
+            chunk.complete = false;
+            return;
+        }
+        if (!weightFits(w)) {
+            chunk.complete = false;
+            chunk.badWeight = w;
+            return;
+        }
+        NodeId a = chunk.ids.intern(u);
+        chunk.edges.push_back({a, chunk.ids.intern(v), (EdgeWeight)w});
+    }
+}
+
+}  // namespace loader_detail
+
+// ===================================================================
+//                      PARALLEL TEXT PARSING
+// ===================================================================
+
+/**
+ * @brief Drop-in replacement for readEdgeListText() that maps the file
+ *        and parses it in parallel.
+ *
+ * @param pool Threads to parse with (nullptr = single-threaded).
+ * @return false (with a message on stderr) if the file cannot be read.
+ */
+inline bool readEdgeListMapped(const std::string& path, EdgeListFormat format, std::vector<Edge>& edges,
+                               std::vector<std::string>& names, ThreadPool* pool = nullptr) {
+    using namespace loader_detail;
+
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "Error: " << path << " not found" << std::endl;
+        return false;
+    }
+    file.advise(MADV_SEQUENTIAL);
+    const char* p = file.data();
+    const char* end = p + file.size();
+
+    long long declaredNodes = -1, m = -1;
+    bool headerOk = true;
+    if (format == EdgeListFormat::NodesEdgesThenEdges) headerOk = parseInteger(nextToken(p, end), declaredNodes);
+    if (!headerOk || !parseInteger(nextToken(p, end), m) || m < 0) {
+        std::cerr << "Error reading file: bad header in " << path << std::endl;
+        return false;
+    }
+
+    // Cut the body into chunks that each start at the beginning of a line.
+    size_t bodySize = (size_t)(end - p);
+    size_t chunkCount = pool ? (size_t)pool->size() * 4 : 1;
+    chunkCount = std::max<size_t>(1, std::min(chunkCount, bodySize / kMinChunkBytes));
+    std::vector<const char*> cut(chunkCount + 1, end);
+    cut[0] = p;
+    for (size_t c = 1; c < chunkCount; ++c) {
+        const char* q = std::max(cut[c - 1], p + bodySize / chunkCount * c);
+        while (q < end && *q != '\n') ++q;
+        cut[c] = q < end ? q + 1 : end;
+    }
+
+    std::vector<ParsedChunk> chunks(chunkCount);
+    auto parseRange = [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c) parseChunk(cut[c], cut[c + 1], chunks[c]);
+    };
+    if (pool) pool->parallelFor(0, chunkCount, 1, parseRange);
+    else parseRange(0, chunkCount);
+
+    // One chunk already has the final ids, unless edges past the first m
+    // introduced names of their own.
+    if (chunkCount == 1 && chunks[0].complete && chunks[0].edges.size() == (size_t)m) {
+        edges = std::move(chunks[0].edges);
+        names.assign(chunks[0].ids.names().begin(), chunks[0].ids.names().end());
+        for (long long i = (long long)names.size(); i < declaredNodes; ++i)
+            names.push_back("#" + std::to_string(i));
+        return true;
+    }
+
+    // Merge the name tables in file order. Only the first m edges count,
+    // so names that appear only after them must not be interned.
+    constexpr NodeId kUnset = std::numeric_limits<NodeId>::max();
+    NameMap global;
+    std::vector<std::vector<NodeId>> remap(chunkCount);
+    std::vector<size_t> base(chunkCount, 0), take(chunkCount, 0);
+    size_t taken = 0;
+    for (size_t c = 0; c < chunkCount && taken < (size_t)m; ++c) {
+        ParsedChunk& chunk = chunks[c];
+        base[c] = taken;
+        take[c] = std::min(chunk.edges.size(), (size_t)m - taken);
+        const std::vector<std::string_view>& local = chunk.ids.names();
+        remap[c].assign(local.size(), kUnset);
+        if (take[c] == chunk.edges.size()) {
+            for (size_t i = 0; i < local.size(); ++i) remap[c][i] = global.intern(local[i]);
+        } else {
+            for (size_t i = 0; i < take[c]; ++i)
+                for (NodeId id : {chunk.edges[i].from, chunk.edges[i].to})
+                    if (remap[c][id] == kUnset) remap[c][id] = global.intern(local[id]);
+        }
+        taken += take[c];
+        if (!chunk.complete && taken < (size_t)m) {
+            if (chunk.badWeight != 0) {
+                std::cerr << "Error reading file: " << path << " edge " << taken + 1 << " has weight "
+                          << chunk.badWeight << " outside the 32-bit range" << std::endl;
+                return false;
+            }
+            break;
+        }
+    }
+    if (taken < (size_t)m) {
+        std::cerr << "Error reading file: " << path << " ends after " << taken << " of " << m << " edges"
+                  << std::endl;
+        return false;
+    }
+
+    edges.assign((size_t)m, Edge{});
+    auto remapRange = [&](size_t lo, size_t hi) {
+        for (size_t c = lo; c < hi; ++c)
+            for (size_t i = 0; i < take[c]; ++i) {
+                const Edge& e = chunks[c].edges[i];
+                edges[base[c] + i] = {remap[c][e.from], remap[c][e.to], e.weight};
+            }
+    };
+    if (pool) pool->parallelFor(0, chunkCount, 1, remapRange);
+    else remapRange(0, chunkCount);
+
+    names.assign(global.names().begin(), global.names().end());
+    for (long long i = (long long)names.size(); i < declaredNodes; ++i)
+        names.push_back("#" + std::to_string(i));
+    return true;
+}
+
+// ===================================================================
+//                       LOADED GRAPH (OWNER)
+// ===================================================================
+
+/**
+ * @brief Owns a graph's storage, either a mapped snapshot or in-memory
+ *        arrays, and exposes it as a CsrView.
+ */
+class LoadedGraph {
+public:
+    LoadedGraph() = default;
+    LoadedGraph(const LoadedGraph&) = delete;
+    LoadedGraph& operator=(const LoadedGraph&) = delete;
+    LoadedGraph(LoadedGraph&&) = default;  // vectors and mappings keep their buffers
+    LoadedGraph& operator=(LoadedGraph&&) = default;
+
+    const CsrView& view() const { return view_; }
+    bool isMapped() const { return file_.isOpen(); }
+
+    /**
+     * @brief Header of the mapped snapshot (only valid if isMapped()).
+     */
+    const SnapshotHeader& header() const { return header_; }
+
+    /**
+     * @brief Takes ownership of an in-memory graph.
+     */
+    void adopt(CsrGraph graph) {
+        file_.close();
+        graph_ = std::move(graph);
+        nameOffsets_.assign(1, 0);
+        nameChars_.clear();
+        for (const std::string& name : graph_.names) {
+            nameChars_.insert(nameChars_.end(), name.begin(), name.end());
+            nameOffsets_.push_back(nameChars_.size());
+        }
+        view_.offsets = {graph_.offsets.data(), graph_.offsets.size()};
+        view_.targets = {graph_.targets.data(), graph_.targets.size()};
+        view_.weights = {graph_.weights.data(), graph_.weights.size()};
+        view_.names = NameTable({nameOffsets_.data(), nameOffsets_.size()}, nameChars_.data());
+    }
+
+    /**
+     * @brief Maps a snapshot written by writeCsrSnapshot().
+     *
+     * Checks the header, that the sections fit in the file, and, in
+     * one sequential pass, that the offsets are monotone and every
+     * target is a node, so a corrupt snapshot cannot send a reader out
+     * of bounds. The arrays are still used in place, not copied.
+     *
+     * @return false if the file is missing, truncated, inconsistent or
+     *         has the wrong magic / version / byte order.
+     */
+    bool openSnapshot(const std::string& path) {
+        using namespace loader_detail;
+        MappedFile file;
+        if (!file.open(path) || file.size() < sizeof(SnapshotHeader)) return false;
+
+        SnapshotHeader h;
+        std::memcpy(&h, file.data(), sizeof h);
+        if (std::memcmp(h.magic, kMagic, sizeof kMagic) != 0 || h.version != kSnapshotVersion ||
+            h.byteOrder != kByteOrderMark)
+            return false;
+
+        // Bounds nodeCount before the nodeCount + 1 below can wrap.
+        if (h.nodeCount >= file.size() / sizeof(uint64_t)) return false;
+        auto fits = [&](uint64_t at, uint64_t count, size_t elem) {
+            return at % kSectionAlign == 0 && at <= file.size() && count <= (file.size() - at) / elem;
+        };
+        if (!fits(h.offsetsAt, h.nodeCount + 1, sizeof(uint64_t)) || !fits(h.targetsAt, h.arcCount, sizeof(NodeId)) ||
+            !fits(h.weightsAt, h.arcCount, sizeof(EdgeWeight)) ||
+            !fits(h.nameOffsetsAt, h.nodeCount + 1, sizeof(uint64_t)) || !fits(h.namesAt, h.nameBytes, 1))
+            return false;
+
+        const char* base = file.data();
+        CsrView v;
+        v.offsets = {reinterpret_cast<const uint64_t*>(base + h.offsetsAt), (size_t)h.nodeCount + 1};
+        v.targets = {reinterpret_cast<const NodeId*>(base + h.targetsAt), (size_t)h.arcCount};
+        v.weights = {reinterpret_cast<const EdgeWeight*>(base + h.weightsAt), (size_t)h.arcCount};
+        ArrayView<uint64_t> nameOffsets(reinterpret_cast<const uint64_t*>(base + h.nameOffsetsAt),
+                                        (size_t)h.nodeCount + 1);
+        if (v.offsets[h.nodeCount] != h.arcCount || nameOffsets[h.nodeCount] != h.nameBytes) return false;
+        for (size_t u = 0; u < (size_t)h.nodeCount; ++u)
+            if (v.offsets[u] > v.offsets[u + 1] || nameOffsets[u] > nameOffsets[u + 1]) return false;
+        for (size_t i = 0; i < (size_t)h.arcCount; ++i)
+            if (v.targets[i] >= h.nodeCount) return false;
+        v.names = NameTable(nameOffsets, base + h.namesAt);
+
+        graph_ = CsrGraph();
+        nameOffsets_.clear();
+        nameChars_.clear();
+        file_ = std::move(file);
+        header_ = h;
+        view_ = v;
+        return true;
+    }
+
+private:
+    MappedFile file_;  // snapshot storage, or
+    CsrGraph graph_;   // in-memory storage
+    std::vector<uint64_t> nameOffsets_;
+    std::vector<char> nameChars_;
+    SnapshotHeader header_{};
+    CsrView view_;
+};
+
+// ===================================================================
+//                        SNAPSHOT WRITING
+// ===================================================================
+
+/**
+ * @brief Writes @p graph as a snapshot (to "<path>.tmp", then renamed,
+ *        so readers never see a half-written file).
+ *
+ * @param source Text file the graph came from (for staleness checks).
+ */
+inline bool writeCsrSnapshot(const std::string& path, const CsrView& graph, EdgeListFormat format,
+                             const std::string& source) {
+    using namespace loader_detail;
+
+    SnapshotHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof kMagic);
+    h.version = kSnapshotVersion;
+    h.byteOrder = kByteOrderMark;
+    h.nodeCount = graph.nodeCount();
+    h.arcCount = graph.arcCount();
+    h.format = (uint32_t)format;
+    SourceStamp stamp;
+    if (stampOf(source, stamp)) {
+        h.sourceSize = stamp.size;
+        h.sourceMtime = stamp.mtime;
+    }
+
+    std::vector<uint64_t> nameOffsets(1, 0);
+    for (size_t i = 0; i < graph.nodeCount(); ++i) nameOffsets.push_back(nameOffsets.back() + graph.names[i].size());
+    h.nameBytes = nameOffsets.back();
+
+    h.offsetsAt = alignUp(sizeof h);
+    h.targetsAt = alignUp(h.offsetsAt + (h.nodeCount + 1) * sizeof(uint64_t));
+    h.weightsAt = alignUp(h.targetsAt + h.arcCount * sizeof(NodeId));
+    h.nameOffsetsAt = alignUp(h.weightsAt + h.arcCount * sizeof(EdgeWeight));
+    h.namesAt = alignUp(h.nameOffsetsAt + (h.nodeCount + 1) * sizeof(uint64_t));
+
+    std::string tmp = path + ".tmp";
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    uint64_t written = 0;
+    auto put = [&](uint64_t at, const void* data, size_t bytes) {
+        static const char zeros[kSectionAlign] = {};
+        out.write(zeros, (std::streamsize)(at - written));
+        out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+        written = at + bytes;
+    };
+    put(0, &h, sizeof h);
+    put(h.offsetsAt, graph.offsets.data(), graph.offsets.size() * sizeof(uint64_t));
+    put(h.targetsAt, graph.targets.data(), graph.targets.size() * sizeof(NodeId));
+    put(h.weightsAt, graph.weights.data(), graph.weights.size() * sizeof(EdgeWeight));
+    put(h.nameOffsetsAt, nameOffsets.data(), nameOffsets.size() * sizeof(uint64_t));
+    put(h.namesAt, nullptr, 0);
+    for (size_t i = 0; i < graph.nodeCount(); ++i) out.write(graph.names[i].data(), (std::streamsize)graph.names[i].size());
+    out.close();
+
+    if (!out || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ===================================================================
+//                         CACHED LOADING
+// ===================================================================
+
+/**
+ * @brief How loadGraphCached() got its graph.
+ */
+struct GraphLoadInfo {
+    std::string snapshotPath;
+    bool fromSnapshot = false;     // mapped an up-to-date snapshot
+    bool snapshotWritten = false;  // parsed the text and saved a new snapshot
+};
+
+/**
+ * @brief Loads @p path through its snapshot "<path>.csr": maps the
+ *        snapshot if it matches the text file, otherwise parses the text
+ *        in parallel and (re)writes the snapshot for the next run.
+ *
+ * A snapshot whose text file no longer exists is still used.
+ */
+inline bool loadGraphCached(const std::string& path, EdgeListFormat format, LoadedGraph& graph,
+                            ThreadPool* pool = nullptr, GraphLoadInfo* info = nullptr) {
+    GraphLoadInfo local;
+    GraphLoadInfo& result = info ? *info : local;
+    result = GraphLoadInfo();
+    result.snapshotPath = path + ".csr";
+
+    loader_detail::SourceStamp stamp;
+    bool haveSource = loader_detail::stampOf(path, stamp);
+    if (graph.openSnapshot(result.snapshotPath)) {
+        const SnapshotHeader& h = graph.header();
+        if (h.format == (uint32_t)format &&
+            (!haveSource || (h.sourceSize == stamp.size && h.sourceMtime == stamp.mtime))) {
+            result.fromSnapshot = true;
+            return true;
+        }
+    }
+
+    std::vector<Edge> edges;
+    std::vector<std::string> names;
+    if (!readEdgeListMapped(path, format, edges, names, pool)) return false;
+    graph.adopt(buildCsr(edges, std::move(names), format == EdgeListFormat::CountThenEdges));
+
+    result.snapshotWritten = writeCsrSnapshot(result.snapshotPath, graph.view(), format, path);
+    if (!result.snapshotWritten)
+        std::cerr << "Note: could not write snapshot " << result.snapshotPath << std::endl;
+    return true;
+}
@@ -0,0 +1,103 @@
+// ===================================================================
+//                INDIRECT SORTING (INDEX / KEY-INDEX)
+// ===================================================================
+//
+// Sorting large records directly moves every record O(log n) times.
+// Indirect sorting sorts small (key, index) pairs instead and touches
+// each record at most twice: once to read its key, and once to move
+// it into place (only if the records must really be reordered).
+//
+//   sortIndices()      -> permutation: order[k] = index of the k-th
+//                         record; the records are NOT moved
+//   applyPermutation() -> moves the records into that order in place,
+//                         every record exactly once (cycle walking)
+//   indirectSort()     -> both, a drop-in for a direct sort
+//
+// Key Notes:
+// - Keys are extracted once with the projection (see ordering.h), so
+//   comparisons never chase pointers into the records; the pairs are
+//   16 bytes for a 64-bit key instead of e.g. 128-byte records.
+// - The pairs are sorted by parallelMergeSort() (on the caller alone
+//   without a ThreadPool), so the order is STABLE.
+// - applyPermutation() needs n bits of scratch, not a second copy of
+//   the records.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "mergeSort.h"  // parallelMergeSort()
+#include "ordering.h"   // Identity
+
+namespace indirect_detail {
+
+template <class Key>
+struct KeyIndex {
+    Key key;
+    size_t index;
+};
+
+}  // namespace indirect_detail
+
+/**
+ * @brief Stable sorted order of [first, last) without moving anything.
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ * @param pool Optional; sorts the pairs with parallelMergeSort().
+ * @return order, with proj(first[order[0]]) first in the sorted order.
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline std::vector<size_t> sortIndices(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {},
+                                       ThreadPool* pool = nullptr) {
+    using Key = std::decay_t<std::invoke_result_t<Proj&, decltype(*first)>>;
+    using Pair = indirect_detail::KeyIndex<Key>;
+    size_t n = (size_t)(last - first);
+
+    std::vector<Pair> pairs(n);
+    for (size_t i = 0; i < n; ++i) pairs[i] = {std::invoke(proj, first[i]), i};
+
+    // Merge sort is stable, so equal keys keep their index order.
+    ThreadPool single(1);
+    parallelMergeSort(pairs.begin(), pairs.end(), pool ? *pool : single, comp, &Pair::key);
+
+    std::vector<size_t> order(n);
+    for (size_t k = 0; k < n; ++k) order[k] = pairs[k].index;
+    return order;
+}
+
+/**
+ * @brief Reorders [first, first + order.size()) so that the element
+ *        at position k is the one that was at order[k]. Each element is
+ *        moved once, following the cycles of the permutation.
+ */
+template <class RandomIt>
+inline void applyPermutation(RandomIt first, const std::vector<size_t>& order) {
+    size_t n = order.size();
+    std::vector<bool> placed(n, false);
+    for (size_t start = 0; start < n; ++start) {
+        if (placed[start]) continue;
+        placed[start] = true;
+        if (order[start] == start) continue;
+
+        // Pull each element of the cycle into the hole it leaves behind.
+        auto carried = std::move(first[start]);
+        size_t hole = start;
+        while (order[hole] != start) {
+            first[hole] = std::move(first[order[hole]]);
+            hole = order[hole];
+            placed[hole] = true;
+        }
+        first[hole] = std::move(carried);
+    }
+}
+
+/**
+ * @brief Stable sort of [first, last) that moves every element once.
+ *        Same arguments as sortIndices().
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline void indirectSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {},
+                         ThreadPool* pool = nullptr) {
+    applyPermutation(first, sortIndices(first, last, comp, proj, pool));
+}
@@ -0,0 +1,116 @@
+// ===================================================================
+//          INTERPOLATION SEARCH & LEARNED INDEX BENCHMARK
+// ===================================================================
+//
+// Compares three lower-bound searches over the same sorted int array:
+//   * lowerBoundSearch() (binarySearch.h): log2(n) probes,
+//   * interpolationLowerBound() (learnedIndex.h),
+//   * LearnedIndex: a two-level RMI with per-leaf error windows.
+//
+// Usage: ./learnedIndex [MAX_N]     (default MAX_N = 10000000)
+//
+// Key Notes:
+// - Two key distributions, n = 10^5 up to MAX_N:
+//     * uniform: sorted uniform values over the whole int range, the
+//       case the models fit best,
+//     * skewed: sorted Zipf values (exponent 0.8 over the int range):
+//       dense and duplicate-heavy at the bottom, a long sparse tail.
+// - Lookups are keys taken at random positions of the array, cycled
+//   through so consecutive lookups touch unrelated parts of it.
+// - For the learned index the build time, the memory on top of the
+//   array and the mean log2 of its search windows are printed.
+// - Every answer is checked against std::lower_bound first.
+//
+// Build: g++ -O2 learnedIndex.cpp -o learnedIndex
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"         // Shared timing harness + CSV writer
+#include "binarySearch.h"      // lowerBoundSearch()
+#include "datasetGenerator.h"  // generateDataset()
+#include "learnedIndex.h"      // interpolationLowerBound(), LearnedIndex
+using namespace std;
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    long long max_n = argc > 1 ? atoll(argv[1]) : 10000000;
+
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    bench::Config cfg;
+    cfg.samples = 15;
+
+    const int num_queries = 1 << 16;
+
+    cout << "--- Interpolation Search & Learned Index (random lookups) ---" << endl;
+
+    for (string profile : {"uniform", "skewed"}) {
+        for (long long n = 100000; n <= max_n; n *= 10) {
+            DatasetSpec spec{profile == "uniform" ? Distribution::Sorted : Distribution::Zipf, (size_t)n};
+            spec.maxValue = numeric_limits<int>::max();
+            spec.zipfExponent = 0.8;
+            vector<int> data = loadDataset(spec);
+            if (profile == "skewed") sort(data.begin(), data.end());
+
+            // Keys at random positions of the array.
+            vector<int> queries(num_queries);
+            mt19937_64 rng(kDefaultSeed);
+            for (int& q : queries) q = data[rng() % n];
+
+            auto build_start = bench::Clock::now();
+            LearnedIndex index(data);
+            double build_ns = bench::elapsedNs(build_start, bench::Clock::now());
+
+            // Same answers as std::lower_bound, for hits and for misses
+            for (int i = 0; i < num_queries; ++i) {
+                int q = i % 2 ? queries[i] : (int)(rng() >> 33);
+                ptrdiff_t lb = lower_bound(data.begin(), data.end(), q) - data.begin();
+                if (lowerBoundSearch(data, q) != lb || interpolationLowerBound(data, q) != lb ||
+                    index.lowerBound(q) != lb) {
+                    cerr << "Error: the searches disagree with std::lower_bound for " << q << endl;
+                    return 1;
+                }
+            }
+
+            double array_bytes = (double)n * sizeof(int);
+            cout << "\n" << profile << " n=" << n << fixed << setprecision(1)
+                 << " | learned index: " << index.leafCount() << " leaves, build " << build_ns / 1e6 << " ms, "
+                 << index.memoryBytes() / 1048576.0 << " MiB (" << setprecision(2)
+                 << 100.0 * (double)index.memoryBytes() / array_bytes << "% of the array), mean log2(window) "
+                 << index.meanLog2Window() << " vs log2(n) " << log2((double)n) << defaultfloat << endl;
+
+            size_t qi = 0;
+            auto next_query = [&] { return queries[qi++ & (num_queries - 1)]; };
+
+            vector<bench::Stats> results = {
+                bench::measure("LowerBound_" + profile + "_binary", n, [&] {
+                    bench::doNotOptimize(lowerBoundSearch(data, next_query()));
+                }, cfg),
+                bench::measure("LowerBound_" + profile + "_interpolation", n, [&] {
+                    bench::doNotOptimize(interpolationLowerBound(data, next_query()));
+                }, cfg),
+                bench::measure("LowerBound_" + profile + "_learned", n, [&] {
+                    bench::doNotOptimize(index.lowerBound(next_query()));
+                }, cfg),
+            };
+
+            for (const bench::Stats& stats : results) {
+                cout << "  " << setw(34) << left << stats.algorithm << right;
+                bench::printStats(stats);
+                csv.write(stats);
+            }
+        }
+    }
+
+    cout << "\nResults appended to " << csv.path() << endl;
+
+    return 0;
+}
@@ -0,0 +1,266 @@
+// ===================================================================
+//              INTERPOLATION SEARCH & LEARNED INDEX
+// ===================================================================
+//
+// Searches over a sorted int array that use the VALUES of the keys,
+// not only their order, to guess where a target is:
+//
+//   interpolationLowerBound() -> probes where target would be if the
+//                                keys were evenly spread between the
+//                                two ends of the current range
+//   LearnedIndex              -> a two-level recursive model index
+//                                (RMI) built once over the array:
+//                                predicts a position, then searches a
+//                                small window around it
+//
+// Both answer lowerBound(target) (first element >= target, or n) and
+// find(target) (index or -1), like binarySearch.h and searchLayouts.h.
+//
+// Key Notes:
+// - On smooth key distributions a probe lands close to the answer:
+//   interpolation search needs O(log log n) probes instead of log2(n).
+//   On skewed data the guesses are poor, so every interpolation step
+//   that does not at least halve the range is followed by a plain
+//   bisection step: never worse than ~2*log2(n) probes.
+// - LearnedIndex:
+//     * the root is a least-squares line from key to leaf model,
+//     * every leaf is a least-squares line from key to position, over
+//       the keys the root sends to it, with the min / max error it
+//       makes on them, so a lookup only binary searches the window
+//       [prediction + minError, prediction + maxError],
+//     * this bound is exact: a target between two keys of a leaf is
+//       predicted between their predictions, and the window is also
+//       clipped to the leaf's own positions.
+//   Skew makes the root put most keys in a few leaves with wide
+//   windows; the lookup then degrades towards a binary search over
+//   that leaf, never below it.
+// - The index keeps a pointer to the sorted vector, which must
+//   outlive it and must not change; memoryBytes() is the overhead on
+//   top of the array itself (32 bytes per leaf).
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+
+// ===================================================================
+//                       INTERPOLATION SEARCH
+// ===================================================================
+
+namespace learned_detail {
+
+// Ranges this small are finished with a binary search.
+constexpr ptrdiff_t kSmallRange = 16;
+
+/**
+ * @brief Branchless lower bound in a[lo, hi).
+ */
+inline ptrdiff_t lowerBoundIn(const int* a, ptrdiff_t lo, ptrdiff_t hi, int target) {
+    const int* base = a + lo;
+    ptrdiff_t len = hi - lo;
+    while (len > 1) {
+        ptrdiff_t half = len / 2;
+        base = base[half - 1] < target ? base + half : base;
+        len -= half;
+    }
+    return (base - a) + (len == 1 && *base < target);
+}
+
+}  // namespace learned_detail
+
+/**
+ * @brief Interpolation search with a bisection guard.
+ * @param arr The sorted array.
+ * @param target The value to look for.
+ * @return Index of the first element >= target, or arr.size().
+ */
+inline ptrdiff_t interpolationLowerBound(const std::vector<int>& arr, int target) {
+    const int* a = arr.data();
+    ptrdiff_t lo = 0, hi = (ptrdiff_t)arr.size();
+    bool bisect = false;
+    // Invariant: everything before lo is < target, everything from hi on is >= target.
+    while (hi - lo > learned_detail::kSmallRange) {
+        int first = a[lo], last = a[hi - 1];
+        if (target <= first) return lo;
+        if (target > last) return hi;
+
+        ptrdiff_t size = hi - lo, mid;
+        if (bisect) {
+            mid = lo + size / 2;
+        } else {
+            double fraction = ((double)target - first) / ((double)last - first);
+            mid = lo + (ptrdiff_t)(fraction * (double)(size - 1));
+        }
+        if (a[mid] < target) lo = mid + 1;
+        else hi = mid;
+        // A probe that did not halve the range was a bad guess.
+        bisect = !bisect && hi - lo > size / 2;
+    }
+    return learned_detail::lowerBoundIn(a, lo, hi, target);
+}
+
+/**
+ * @brief Interpolation search for target.
+ * @return Index of target in arr, or -1 if absent.
+ */
+inline ptrdiff_t interpolationSearch(const std::vector<int>& arr, int target) {
+    ptrdiff_t pos = interpolationLowerBound(arr, target);
+    return (pos < (ptrdiff_t)arr.size() && arr[pos] == target) ? pos : -1;
+}
+
+// ===================================================================
+//                 LEARNED INDEX (TWO-LEVEL RMI)
+// ===================================================================
+
+class LearnedIndex {
+public:
+    static constexpr size_t kDefaultKeysPerLeaf = 256;
+
+    /**
+     * @brief Builds the index over an already sorted vector.
+     * @param sorted The array to index; must outlive the index.
+     * @param keysPerLeaf Average keys per leaf model; fewer means
+     *        narrower windows and more memory.
+     */
+    explicit LearnedIndex(const std::vector<int>& sorted, size_t keysPerLeaf = kDefaultKeysPerLeaf)
+        : keys_(sorted.data()), n_((ptrdiff_t)sorted.size()) {
+        size_t leafCount = std::max<size_t>(1, sorted.size() / std::max<size_t>(1, keysPerLeaf));
+        leaves_.assign(leafCount + 1, Leaf{});  // + a sentinel holding n
+        if (n_ == 0) return;
+
+        // Root: least-squares line from key to position, scaled to leaves.
+        Line root = fit(0, n_);
+        double scale = (double)leafCount / (double)n_;
+        rootSlope_ = root.slope * scale;
+        rootIntercept_ = root.intercept * scale;
+
+        // The root is monotonic, so every leaf gets a contiguous run.
+        size_t leaf = 0;
+        for (ptrdiff_t i = 0; i < n_; ++i) {
+            size_t target = rootLeaf(keys_[i]);
+            while (leaf < target) leaves_[++leaf].start = i;
+        }
+        while (leaf < leafCount) leaves_[++leaf].start = n_;
+
+        for (size_t l = 0; l < leafCount; ++l) buildLeaf(l);
+    }
+
+    /**
+     * @brief Index (in the sorted array) of the first element >= target,
+     *        or n if every element is smaller.
+     */
+    ptrdiff_t lowerBound(int target) const {
+        if (n_ == 0) return 0;
+        size_t l = rootLeaf(target);
+        const Leaf& leaf = leaves_[l];
+        ptrdiff_t begin = leaf.start, end = leaves_[l + 1].start;
+        ptrdiff_t predicted = (ptrdiff_t)std::floor(leaf.slope * (double)target + leaf.intercept);
+        ptrdiff_t lo = std::clamp(predicted + leaf.minError, begin, end);
+        ptrdiff_t hi = std::clamp(predicted + leaf.maxError, begin, end);
+        return learned_detail::lowerBoundIn(keys_, lo, hi, target);
+    }
+
+    /**
+     * @brief Index of target in the sorted array, or -1 if absent.
+     */
+    ptrdiff_t find(int target) const {
+        ptrdiff_t pos = lowerBound(target);
+        return (pos < n_ && keys_[pos] == target) ? pos : -1;
+    }
+
+    size_t size() const { return (size_t)n_; }
+    size_t leafCount() const { return leaves_.size() - 1; }
+
+    /**
+     * @brief Bytes used on top of the sorted array.
+     */
+    size_t memoryBytes() const {
+        return sizeof(*this) + leaves_.size() * sizeof(Leaf);
+    }
+
+    /**
+     * @brief Mean over the keys of log2 of the window searched for
+     *        them: the expected number of probes after the prediction.
+     */
+    double meanLog2Window() const {
+        double sum = 0;
+        for (size_t l = 0; l + 1 < leaves_.size(); ++l) {
+            double window = (double)(leaves_[l].maxError - leaves_[l].minError + 1);
+            sum += (double)(leaves_[l + 1].start - leaves_[l].start) * std::log2(window);
+        }
+        return n_ == 0 ? 0.0 : sum / (double)n_;
+    }
+
+private:
+    struct Line {
+        double slope = 0, intercept = 0;
+    };
+
+    // 32 bytes; a leaf covers positions [start, next leaf's start).
+    struct Leaf {
+        double slope = 0, intercept = 0;
+        int32_t minError = 0, maxError = 0;  // answer - prediction over the leaf's keys
+        ptrdiff_t start = 0;
+    };
+
+    /**
+     * @brief Least-squares line through (keys_[i], i) for i in [begin, end).
+     */
+    Line fit(ptrdiff_t begin, ptrdiff_t end) const {
+        ptrdiff_t count = end - begin;
+        if (count <= 0) return {};
+        // Centered sums: exact enough for 2^31-wide keys and 10^9 positions.
+        double meanX = 0, meanY = 0;
+        for (ptrdiff_t i = begin; i < end; ++i) {
+            meanX += keys_[i];
+            meanY += (double)i;
+        }
+        meanX /= (double)count;
+        meanY /= (double)count;
+        double sxy = 0, sxx = 0;
+        for (ptrdiff_t i = begin; i < end; ++i) {
+            double dx = keys_[i] - meanX;
+            sxy += dx * ((double)i - meanY);
+            sxx += dx * dx;
+        }
+        Line line;
+        line.slope = sxx > 0 ? std::max(0.0, sxy / sxx) : 0.0;
+        line.intercept = meanY - line.slope * meanX;
+        return line;
+    }
+
+    size_t rootLeaf(int key) const {
+        double leaf = rootSlope_ * (double)key + rootIntercept_;
+        return (size_t)std::clamp(leaf, 0.0, (double)(leaves_.size() - 2));
+    }
+
+    void buildLeaf(size_t l) {
+        Leaf& leaf = leaves_[l];
+        ptrdiff_t begin = leaf.start, end = leaves_[l + 1].start;
+        Line line = fit(begin, end);
+        leaf.slope = line.slope;
+        leaf.intercept = line.intercept;
+        leaf.minError = leaf.maxError = 0;
+
+        // A key's answer runs from its first copy to one past its last
+        // one; the window must cover both ends for every key.
+        bool firstRun = true;
+        for (ptrdiff_t i = begin; i < end;) {
+            ptrdiff_t j = i + 1;
+            while (j < end && keys_[j] == keys_[i]) ++j;
+            ptrdiff_t predicted = (ptrdiff_t)std::floor(leaf.slope * (double)keys_[i] + leaf.intercept);
+            ptrdiff_t low = std::max<ptrdiff_t>(i - predicted, INT32_MIN);
+            ptrdiff_t high = std::min<ptrdiff_t>(j - predicted, INT32_MAX);
+            leaf.minError = firstRun ? (int32_t)low : std::min(leaf.minError, (int32_t)low);
+            leaf.maxError = firstRun ? (int32_t)high : std::max(leaf.maxError, (int32_t)high);
+            firstRun = false;
+            i = j;
+        }
+    }
+
+    const int* keys_;
+    ptrdiff_t n_;
+    double rootSlope_ = 0, rootIntercept_ = 0;
+    std::vector<Leaf> leaves_;
+};
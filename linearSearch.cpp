@@ -1,98 +1,113 @@
+// Linear Search benchmark: the scalar loop on small arrays, then the
+// SIMD / multithreaded scan modes on large ones, reported in GB/s so
+// they can be compared against the machine's memory bandwidth.
+// The largest size can be passed as first argument: ./linearSearch 1000000000
+//
+// Build: g++ -O2 -march=native -pthread linearSearch.cpp -o linearSearch
+
 // Includes all standard libraries, common in competitive programming
 #include <bits/stdc++.h>
-#include <fstream> // for file output
+#include "benchmark.h" // shared timing harness + CSV writer
+#include "datasetGenerator.h" // loadDataset(): seeded, cached inputs
+#include "linearSearch.h" // linearSearch() and the SIMD / multithreaded scan modes
 
 // Use the standard and chrono namespaces to avoid writing "std::"
 using namespace std;
 using namespace std::chrono;
 
-/**
- * @brief Generates a vector of high-quality random integers.
- * @param size The number of integers to generate.
- * @return A vector of the specified size containing random integers.
- */
-vector<int> generateRandomVector(int size) {
-    vector<int> vec(size);
-
-    // Modern C++ random number generation
-    random_device rd;      // Obtains a truly random seed from the hardware
-    mt19937 gen(rd());     // Mersenne Twister engine, a high-quality generator
-    uniform_int_distribution<> distrib(0, 100000); // Ensures numbers are uniform in this range
-
-    for (int i = 0; i < size; ++i) {
-        vec[i] = distrib(gen);
-    }
-    return vec;
-}
-
-
-/**
- * @brief Performs a linear search for a target value in a vector.
- * The vector is passed by constant reference (`const&`) for efficiency,
- * as it prevents making a slow copy of the whole vector.
- * @param arr The vector to search through.
- * @param target The value to search for.
- * @return The index of the target if found, otherwise -1.
- */
-int linearSearch(const vector<int>& arr, int target) {
-    for (int i = 0; i < arr.size(); ++i) {
-        if (arr[i] == target) {
-            return i; // Target found
-        }
-    }
-    return -1; // Target not found
-}
-
-
-int main() {
+int main(int argc, char** argv) {
     // A list of input sizes 'n' to benchmark
     vector<int> n_values = {1, 10, 100, 1000, 10000};
 
-    // Number of times to repeat the test for each 'n' to get a stable average
-    int runs_per_n = 30;
-
-    // Open CSV file
-    ofstream csv("linear_search.csv");
-    csv << "Input Size,Avg Time (ns)\n";
+    // Results go to the same CSV as every other algorithm
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
 
     // --- Print Report Header ---
     cout << "--- Linear Search Benchmark ---" << endl;
-    cout << "Averaged over " << runs_per_n << " runs for each input size." << endl;
-    cout << "------------------------------------------" << endl;
-    cout << "Input Size (n) | Avg. Time (nanoseconds)" << endl;
+    cout << "Per-call times; fast calls are batched to hide clock overhead." << endl;
     cout << "------------------------------------------" << endl;
 
     // --- Main Benchmarking Loop ---
     // This loop iterates through each value of 'n' (1, 10, 100, ...)
     for (int n : n_values) {
 
-        // Use 'long long' to store total time, preventing overflow with many runs
-        long long total_duration = 0;
+        // 1. Generate the data once, outside the timed region
+        vector<int> data = loadDataset({Distribution::Uniform, (size_t)n});
+        int target = -1; // Guarantees worst-case (element is not present)
 
-        // --- Averaging Loop ---
-        // This inner loop runs the test 'runs_per_n' times for the current 'n'
-        for (int i = 0; i < runs_per_n; ++i) {
+        // 2. Time the algorithm (warmup, batching and statistics are
+        //    handled by the shared harness)
+        bench::Stats stats = bench::measure("LinearSearch", n, [&] {
+            bench::doNotOptimize(linearSearch(data, target));
+        });
 
-            // 1. Generate fresh data for each run to ensure fairness
-            vector<int> data = generateRandomVector(n);
-            int target = -1; // Guarantees worst-case (element is not present)
-
-            // 2. Time the algorithm
-            auto start = high_resolution_clock::now();
-            linearSearch(data, target);
-            auto end = high_resolution_clock::now();
+        // Print + Save at the same time
+        bench::printStats(stats);
+        csv.write(stats);  // save to CSV
+    }
 
-            // 3. Add the duration of this single run to our total
-            total_duration += duration_cast<nanoseconds>(end - start).count();
+    // --- Fast Scan Modes ---
+    // Worst case for find-first (target absent), so every mode reads the
+    // whole array and GB/s = bytes scanned / time.
+    long long max_n = argc > 1 ? atoll(argv[1]) : 100000000;
+    ThreadPool pool;
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 10;
+
+    cout << "\n--- Fast Scan Modes (" << pool.size() << " threads available) ---" << endl;
+
+    for (long long n = 1000; n <= max_n; n *= 10) {
+        vector<int> data = loadDataset({Distribution::Uniform, (size_t)n}, &pool);
+        int absent = -1;
+        int present = data[n / 2];
+
+        // Every mode must agree with the scalar reference
+        long long first = linearSearch(data, present);
+        vector<size_t> all = linearFindAll(data, present, &pool);
+        if (linearFindFirst(data, present) != first || linearFindFirst(data, present, &pool) != first ||
+            linearCount(data, present, &pool) != all.size() ||
+            all.size() != (size_t)count(data.begin(), data.end(), present) || all.front() != (size_t)first ||
+            linearFindFirst(data, absent, &pool) != -1) {
+            cerr << "Error: fast scan modes disagree with linearSearch()" << endl;
+            return 1;
         }
 
-        long long average_duration = total_duration / runs_per_n;
+        vector<bench::Stats> results = {
+            bench::measure("LinearSearch", n, [&] {
+                bench::doNotOptimize(linearSearch(data, absent));
+            }, cfg),
+            bench::measure("LinearFindFirst", n, [&] {
+                bench::doNotOptimize(linearFindFirst(data, absent));
+            }, cfg),
+            bench::measure("LinearFindFirst_t" + to_string(pool.size()), n, [&] {
+                bench::doNotOptimize(linearFindFirst(data, absent, &pool));
+            }, cfg),
+            bench::measure("LinearCount_t" + to_string(pool.size()), n, [&] {
+                bench::doNotOptimize(linearCount(data, present, &pool));
+            }, cfg),
+            bench::measure("LinearFindAll_t" + to_string(pool.size()), n, [&] {
+                bench::doNotOptimize(linearFindAll(data, present, &pool).size());
+            }, cfg),
+        };
+
+        cout << "n=" << n << endl;
+        for (const bench::Stats& stats : results) {
+            double gb_per_s = n * sizeof(int) / stats.medianNs;  // bytes/ns == GB/s
+            cout << "  " << setw(20) << left << stats.algorithm << right
+                 << fixed << setprecision(2) << setw(8) << gb_per_s << " GB/s  "
+                 << defaultfloat;
+            bench::printStats(stats);
+            csv.write(stats);
+        }
+    }
 
-        // Print + Save at the same time
-        cout << setw(10) << n << " | " << setw(15) << average_duration << endl;
-        csv << n << "," << average_duration << "\n";  // save to CSV
-}
-        csv.close();  // close file
+    cout << "\nResults appended to " << csv.path() << endl;
 
     return 0;
 }
@@ -0,0 +1,276 @@
+// ===================================================================
+//                      LINEAR SEARCH ALGORITHMS
+// ===================================================================
+//
+// Scans over UNSORTED arrays, shared by linearSearch.cpp and
+// the other programs that need them.
+//
+// Key Notes:
+// - linearSearch() is the plain scalar loop (first index or -1),
+//   templated over the element type, an equality predicate and a
+//   projection (see ordering.h), for a vector or an iterator range.
+// - linearFindFirst(), linearFindAll() and linearCount() are the fast
+//   scan modes. They compare 16 ints per step with AVX2 (8 with SSE2,
+//   scalar otherwise) and stop at the first match where that applies.
+// - Given a ThreadPool and an array much larger than the caches, the
+//   array is cut into fixed blocks that threads claim in increasing
+//   order. linearFindFirst() stays exact: a block is skipped only if
+//   it starts after a match that was already found, so the EARLIEST
+//   match is always returned.
+// - Indices are 64-bit, so arrays beyond 2^31 elements work.
+// - Build with -march=native (or -mavx2) to enable the AVX2 path.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "ordering.h"  // Identity
+#include "threadPool.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// ===================================================================
+//                        SCALAR LINEAR SEARCH
+// ===================================================================
+
+/**
+ * @brief Performs a linear search over [first, last).
+ * @param first, last The range to search through (any order).
+ * @param target The key to search for.
+ * @param eq Equality on keys (default ==)
+ * @param proj Projection from element to key (default the element)
+ * @return The index of the first match, otherwise -1.
+ */
+template <class InputIt, class Key, class Equal = std::equal_to<>, class Proj = Identity>
+inline ptrdiff_t linearSearch(InputIt first, InputIt last, const Key& target, Equal eq = {}, Proj proj = {}) {
+    for (ptrdiff_t i = 0; first != last; ++first, ++i) {
+        if (eq(std::invoke(proj, *first), target)) {
+            return i; // Target found
+        }
+    }
+    return -1; // Target not found
+}
+
+/**
+ * @brief Performs a linear search for a target value in a vector.
+ * The vector is passed by constant reference (`const&`) for efficiency,
+ * as it prevents making a slow copy of the whole vector.
+ * @param arr The vector to search through.
+ * @param target The value to search for.
+ * @return The index of the target if found, otherwise -1.
+ */
+template <class T, class Key, class Equal = std::equal_to<>, class Proj = Identity>
+inline ptrdiff_t linearSearch(const std::vector<T>& arr, const Key& target, Equal eq = {}, Proj proj = {}) {
+    return linearSearch(arr.begin(), arr.end(), target, eq, proj);
+}
+
+// ===================================================================
+//                        SIMD SCAN KERNELS
+// ===================================================================
+
+namespace linear_detail {
+
+// Arrays smaller than this (16 MiB of ints) are scanned by one thread.
+constexpr size_t kParallelThreshold = 1 << 22;
+// Unit of work a thread claims at a time (256 KiB of ints).
+constexpr size_t kBlock = 1 << 16;
+
+/**
+ * @brief Index of the first a[i] == target in [begin, end), or end.
+ */
+inline size_t findFirst(const int* a, size_t begin, size_t end, int target) {
+    size_t i = begin;
+#if defined(__AVX2__)
+    __m256i x = _mm256_set1_epi32(target);
+    for (; i + 16 <= end; i += 16) {
+        __m256i e0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a + i)), x);
+        __m256i e1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a + i + 8)), x);
+        if (!_mm256_testz_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e0, e1))) {
+            unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(e0)) |
+                            ((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(e1)) << 8);
+            return i + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    __m128i x = _mm_set1_epi32(target);
+    for (; i + 8 <= end; i += 8) {
+        __m128i e0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i)), x);
+        __m128i e1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i + 4)), x);
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(e0)) |
+                        ((unsigned)_mm_movemask_ps(_mm_castsi128_ps(e1)) << 4);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < end; ++i)
+        if (a[i] == target) return i;
+    return end;
+}
+
+/**
+ * @brief Number of a[i] == target in [begin, end).
+ */
+inline size_t countEqual(const int* a, size_t begin, size_t end, int target) {
+    size_t i = begin, count = 0;
+#if defined(__AVX2__)
+    __m256i x = _mm256_set1_epi32(target);
+    // Equal lanes are -1, so subtracting the compare result counts them.
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    for (; i + 16 <= end; i += 16) {
+        acc0 = _mm256_sub_epi32(acc0, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a + i)), x));
+        acc1 = _mm256_sub_epi32(acc1, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a + i + 8)), x));
+    }
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256((__m256i*)lanes, _mm256_add_epi32(acc0, acc1));
+    for (uint32_t lane : lanes) count += lane;
+#elif defined(__SSE2__)
+    __m128i x = _mm_set1_epi32(target);
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    for (; i + 8 <= end; i += 8) {
+        acc0 = _mm_sub_epi32(acc0, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i)), x));
+        acc1 = _mm_sub_epi32(acc1, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i + 4)), x));
+    }
+    alignas(16) uint32_t lanes[4];
+    _mm_store_si128((__m128i*)lanes, _mm_add_epi32(acc0, acc1));
+    for (uint32_t lane : lanes) count += lane;
+#endif
+    for (; i < end; ++i) count += a[i] == target;
+    return count;
+}
+
+/**
+ * @brief Appends every i in [begin, end) with a[i] == target to out.
+ */
+inline void findAll(const int* a, size_t begin, size_t end, int target, std::vector<size_t>& out) {
+    size_t i = begin;
+#if defined(__AVX2__)
+    __m256i x = _mm256_set1_epi32(target);
+    for (; i + 16 <= end; i += 16) {
+        __m256i e0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a + i)), x);
+        __m256i e1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a + i + 8)), x);
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(e0)) |
+                        ((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(e1)) << 8);
+        while (mask) {
+            out.push_back(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__SSE2__)
+    __m128i x = _mm_set1_epi32(target);
+    for (; i + 8 <= end; i += 8) {
+        __m128i e0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i)), x);
+        __m128i e1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i + 4)), x);
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(e0)) |
+                        ((unsigned)_mm_movemask_ps(_mm_castsi128_ps(e1)) << 4);
+        while (mask) {
+            out.push_back(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < end; ++i)
+        if (a[i] == target) out.push_back(i);
+}
+
+/**
+ * @brief Runs worker() on every thread of the pool and waits.
+ */
+template <class Worker>
+void onAllThreads(ThreadPool& pool, Worker&& worker) {
+    ThreadPool::TaskGroup group(pool);
+    for (unsigned t = 1; t < pool.size(); ++t) group.run([&worker] { worker(); });
+    worker();
+    group.wait();
+}
+
+inline bool useThreads(ThreadPool* pool, size_t n) {
+    return pool && pool->size() > 1 && n >= kParallelThreshold;
+}
+
+}  // namespace linear_detail
+
+// ===================================================================
+//                      FAST SCAN MODES (PUBLIC)
+// ===================================================================
+
+/**
+ * @brief Index of the first element equal to target, or -1.
+ * @param arr    The (unsorted) vector to scan.
+ * @param target The value to search for.
+ * @param pool   Optional; very large arrays are scanned in parallel.
+ */
+inline long long linearFindFirst(const std::vector<int>& arr, int target, ThreadPool* pool = nullptr) {
+    using namespace linear_detail;
+    size_t n = arr.size();
+    if (!useThreads(pool, n)) {
+        size_t pos = findFirst(arr.data(), 0, n, target);
+        return pos == n ? -1 : (long long)pos;
+    }
+
+    size_t blocks = (n + kBlock - 1) / kBlock;
+    std::atomic<size_t> nextBlock{0};
+    std::atomic<size_t> best{n};
+
+    onAllThreads(*pool, [&] {
+        size_t b;
+        while ((b = nextBlock.fetch_add(1, std::memory_order_relaxed)) < blocks) {
+            size_t begin = b * kBlock;
+            // Blocks are claimed in order: everything after a known match is useless.
+            if (begin >= best.load(std::memory_order_relaxed)) return;
+            size_t end = std::min(n, begin + kBlock);
+            size_t pos = findFirst(arr.data(), begin, end, target);
+            if (pos != end) {
+                size_t cur = best.load(std::memory_order_relaxed);
+                while (pos < cur && !best.compare_exchange_weak(cur, pos)) {}
+                return;
+            }
+        }
+    });
+
+    size_t pos = best.load();
+    return pos == n ? -1 : (long long)pos;
+}
+
+/**
+ * @brief Number of elements equal to target.
+ */
+inline size_t linearCount(const std::vector<int>& arr, int target, ThreadPool* pool = nullptr) {
+    using namespace linear_detail;
+    size_t n = arr.size();
+    if (!useThreads(pool, n)) return countEqual(arr.data(), 0, n, target);
+
+    std::atomic<size_t> total{0};
+    pool->parallelFor(0, n, kBlock, [&](size_t lo, size_t hi) {
+        total.fetch_add(countEqual(arr.data(), lo, hi, target), std::memory_order_relaxed);
+    });
+    return total.load();
+}
+
+/**
+ * @brief Every index whose element equals target, in increasing order.
+ */
+inline std::vector<size_t> linearFindAll(const std::vector<int>& arr, int target, ThreadPool* pool = nullptr) {
+    using namespace linear_detail;
+    size_t n = arr.size();
+    std::vector<size_t> result;
+    if (!useThreads(pool, n)) {
+        findAll(arr.data(), 0, n, target, result);
+        return result;
+    }
+
+    // One fixed slice per block, concatenated in block order.
+    size_t blocks = (n + kBlock - 1) / kBlock;
+    std::vector<std::vector<size_t>> partial(blocks);
+    pool->parallelFor(0, blocks, 1, [&](size_t lo, size_t hi) {
+        for (size_t b = lo; b < hi; ++b)
+            findAll(arr.data(), b * kBlock, std::min(n, (b + 1) * kBlock), target, partial[b]);
+    });
+
+    size_t total = 0;
+    for (const auto& p : partial) total += p.size();
+    result.reserve(total);
+    for (const auto& p : partial) result.insert(result.end(), p.begin(), p.end());
+    return result;
+}
@@ -0,0 +1,112 @@
+// ===================================================================
+//                     READ-ONLY MEMORY-MAPPED FILE
+// ===================================================================
+//
+// RAII wrapper around mmap() for programs that read large input files
+// (graph edge lists, binary snapshots, cached datasets).
+//
+// Key Notes:
+// - The whole file is mapped read-only and MAP_PRIVATE; pages are
+//   faulted in on first touch, so opening is O(1) whatever the size.
+// - An empty file is a valid, open mapping with data() == nullptr.
+// - Move-only: the mapping is released exactly once, by the owner.
+// - POSIX only (Linux / macOS), like the rest of the parallel code.
+// - ArrayView gives typed, bounds-known access to arrays stored in
+//   a mapping without copying them.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            open_ = std::exchange(other.open_, false);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Maps @p path. Returns false if it cannot be opened or mapped.
+     */
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        bool ok = ::fstat(fd, &st) == 0;
+        if (ok && st.st_size > 0) {
+            void* p = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = p != MAP_FAILED;
+            if (ok) {
+                data_ = static_cast<const char*>(p);
+                size_ = (size_t)st.st_size;
+            }
+        }
+        ::close(fd);  // the mapping stays valid without the descriptor
+        open_ = ok;
+        return ok;
+    }
+
+    void close() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+        open_ = false;
+    }
+
+    /**
+     * @brief Access-pattern hint (MADV_SEQUENTIAL, MADV_WILLNEED, ...).
+     */
+    void advise(int advice) const {
+        if (data_) ::madvise(const_cast<char*>(data_), size_, advice);
+    }
+
+    bool isOpen() const { return open_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+};
+
+/**
+ * @brief Pointer + length, for arrays that may live in a mapped file.
+ */
+template <class T>
+class ArrayView {
+public:
+    ArrayView() = default;
+    ArrayView(const T* data, size_t size) : data_(data), size_(size) {}
+
+    const T& operator[](size_t i) const { return data_[i]; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
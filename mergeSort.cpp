@@ -3,112 +3,189 @@
 // ===================================================================
 //
 // This program benchmarks Merge Sort on arrays of different input sizes.
-// Results are averaged over multiple runs for stability and appended
+// Results are measured over multiple runs for stability and appended
 // to the same CSV as other algorithms.
 //
 // Key Notes:
 // - Merge Sort is a divide-and-conquer sorting algorithm.
 // - The target is the array itself; we time the sorting process only.
 // - Time complexity: O(n log n) in worst case.
+// - A second section sorts one large input with parallelMergeSort()
+//   on 1, 2, 4, ... up to all hardware threads to show scaling.
+//   The size can be passed as the first argument: ./mergeSort 10000000
+// - A third section compares adaptiveMergeSort() (powersort) with the
+//   classic and 1-thread parallel versions and std::stable_sort on the
+//   presorted profiles (sorted, nearly-sorted, k-sorted with distances
+//   64 and 4096, reversed) and on uniform input, and prints the compares
+//   per element each sort needs. Size: second argument (default 1000000).
+//
+// Build: g++ -O2 -pthread mergeSort.cpp -o mergeSort
 //
 // ===================================================================
 
 #include <bits/stdc++.h>
-#include <fstream>   // For file I/O
+#include "benchmark.h"         // Shared timing harness + CSV writer
+#include "datasetGenerator.h"  // loadDataset(): seeded, cached inputs
+#include "mergeSort.h"         // mergeSort(), parallelMergeSort(), adaptiveMergeSort()
 using namespace std;
 using namespace std::chrono;
 
-// ===================================================================
-//                       HELPER FUNCTIONS
-// ===================================================================
-
-/**
- * @brief Generates a vector of high-quality random integers.
- */
-vector<int> generateRandomVector(int size) {
-    vector<int> vec(size);
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> distrib(0, 100000);
-
-    for (int i = 0; i < size; ++i) {
-        vec[i] = distrib(gen);
-    }
-    return vec;
-}
-
-// ===================================================================
-//                         MERGE SORT
-// ===================================================================
-
-void merge(vector<int>& arr, int left, int mid, int right) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-
-    vector<int> L(n1), R(n2);
-
-    for (int i = 0; i < n1; ++i) L[i] = arr[left + i];
-    for (int j = 0; j < n2; ++j) R[j] = arr[mid + 1 + j];
-
-    int i = 0, j = 0, k = left;
-    while (i < n1 && j < n2) {
-        if (L[i] <= R[j]) arr[k++] = L[i++];
-        else arr[k++] = R[j++];
-    }
-
-    while (i < n1) arr[k++] = L[i++];
-    while (j < n2) arr[k++] = R[j++];
-}
-
-void mergeSort(vector<int>& arr, int left, int right) {
-    if (left >= right) return;
-
-    int mid = left + (right - left) / 2;
-    mergeSort(arr, left, mid);
-    mergeSort(arr, mid + 1, right);
-    merge(arr, left, mid, right);
-}
-
 // ===================================================================
 //                          MAIN FUNCTION
 // ===================================================================
 
-int main() {
+int main(int argc, char** argv) {
     vector<int> n_values = {1, 10, 100, 1000, 10000};
-    int runs_per_n = 20;
 
-    ofstream csv("benchmark_results.csv", ios::app); // Append mode
-    if (!csv.is_open()) {
+    bench::ResultWriter csv; // Append mode
+    if (!csv.isOpen()) {
         cout << "Error opening CSV file!" << endl;
         return 1;
     }
 
     cout << "--- Merge Sort Benchmark ---" << endl;
-    cout << "Averaged over " << runs_per_n << " runs per input size.\n" << endl;
+    cout << "Each sample sorts a fresh copy of the same random input.\n" << endl;
 
     for (int n : n_values) {
-        long long total_duration = 0;
+        const vector<int> input = loadDataset({Distribution::Uniform, (size_t)n});
+        vector<int> data;
 
-        for (int i = 0; i < runs_per_n; ++i) {
-            vector<int> data = generateRandomVector(n);
+        bench::Stats stats = bench::measureWithSetup(
+            "MergeSort", n,
+            [&] { data = input; },
+            [&] { mergeSort(data, 0, data.size() - 1); });
 
-            auto start = high_resolution_clock::now();
-            mergeSort(data, 0, data.size() - 1);
-            auto end = high_resolution_clock::now();
+        bench::printStats(stats);
 
-            total_duration += duration_cast<nanoseconds>(end - start).count();
-        }
+        csv.write(stats);
+    }
 
-        long long average_duration = total_duration / runs_per_n;
+    // ---------------------------------------------------------------
+    //        Parallel merge sort: classic vs. 1..N threads
+    // ---------------------------------------------------------------
+    int scaling_n = argc > 1 ? atoi(argv[1]) : 4000000;
+    unsigned max_threads = max(1u, thread::hardware_concurrency());
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 10;
+
+    const vector<int> input = loadDataset({Distribution::Uniform, (size_t)scaling_n});
+    vector<int> expected = input;
+    sort(expected.begin(), expected.end());
+    vector<int> data;
+
+    cout << "\n--- Parallel Merge Sort Scaling (n=" << scaling_n << ") ---" << endl;
+
+    bench::Stats classic = bench::measureWithSetup(
+        "MergeSort", scaling_n,
+        [&] { data = input; },
+        [&] { mergeSort(data, 0, data.size() - 1); }, cfg);
+    cout << "classic     ";
+    bench::printStats(classic);
+    csv.write(classic);
+
+    // 1, 2, 4, ... and always the full machine
+    vector<unsigned> thread_counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    double one_thread_ns = 0;
+    for (unsigned t : thread_counts) {
+        ThreadPool pool(t);
+        bench::Stats stats = bench::measureWithSetup(
+            "ParallelMergeSort_t" + to_string(t), scaling_n,
+            [&] { data = input; },
+            [&] { parallelMergeSort(data, pool); }, cfg);
+
+        if (data != expected) {
+            cerr << "Error: parallelMergeSort produced a wrong result with " << t << " threads" << endl;
+            return 1;
+        }
+        if (t == 1) one_thread_ns = stats.medianNs;
+
+        cout << "threads=" << setw(3) << t << " ";
+        bench::printStats(stats);
+        cout << "            speedup vs classic = " << fixed << setprecision(2)
+             << classic.medianNs / stats.medianNs << "x, vs 1 thread = "
+             << one_thread_ns / stats.medianNs << "x" << defaultfloat << endl;
+        csv.write(stats);
+    }
 
-        cout << "n=" << n << " | Avg Time = "
-             << average_duration << " ns" << endl;
+    // ---------------------------------------------------------------
+    //        Adaptive merge sort on partially sorted input
+    // ---------------------------------------------------------------
+    size_t adaptive_n = argc > 2 ? stoull(argv[2]) : 1000000;
+    cout << "\n--- Adaptive Merge Sort on presorted input (n=" << adaptive_n << ") ---" << endl;
+
+    struct Profile {
+        string name;
+        DatasetSpec spec;
+    };
+    vector<Profile> profiles;
+    for (Distribution d : {Distribution::Sorted, Distribution::NearlySorted, Distribution::KSorted,
+                           Distribution::KSorted, Distribution::Reversed, Distribution::Uniform}) {
+        DatasetSpec spec{d, adaptive_n};
+        spec.maxValue = numeric_limits<int>::max();
+        string name = distributionName(d);
+        if (d == Distribution::KSorted) {
+            spec.sortedDistance = profiles.back().spec.distribution == Distribution::KSorted ? 4096 : 64;
+            name += to_string(spec.sortedDistance);
+        }
+        profiles.push_back({name, spec});
+    }
 
-        csv << "MergeSort," << n << "," << average_duration << "\n";
+    ThreadPool one_thread(1);
+    for (const Profile& profile : profiles) {
+        const vector<int> input = loadDataset(profile.spec);
+        vector<int> expected = input;
+        sort(expected.begin(), expected.end());
+        cout << "\n" << profile.name << ":" << endl;
+
+        // Sorts with a counting comparator show the work each one skips.
+        long long compares = 0;
+        auto counting = [&compares](int a, int b) {
+            ++compares;
+            return a < b;
+        };
+        vector<pair<string, function<void(bool)>>> sorts = {
+            {"MergeSort", [&](bool count) {
+                 if (count) mergeSort(data, 0, data.size() - 1, counting);
+                 else mergeSort(data, 0, data.size() - 1);
+             }},
+            {"ParallelMergeSort_t1", [&](bool count) {
+                 if (count) parallelMergeSort(data, one_thread, counting);
+                 else parallelMergeSort(data, one_thread);
+             }},
+            {"AdaptiveMergeSort", [&](bool count) {
+                 if (count) adaptiveMergeSort(data, counting);
+                 else adaptiveMergeSort(data);
+             }},
+            {"StdStableSort", [&](bool count) {
+                 if (count) stable_sort(data.begin(), data.end(), counting);
+                 else stable_sort(data.begin(), data.end());
+             }},
+        };
+        for (auto& [name, sortAll] : sorts) {
+            data = input;
+            compares = 0;
+            sortAll(true);
+            bench::Stats stats = bench::measureWithSetup(
+                name + "_" + profile.name, (long long)adaptive_n,
+                [&] { data = input; },
+                [&] { sortAll(false); }, cfg);
+            if (data != expected) {
+                cerr << "Error: " << name << " produced a wrong result on " << profile.name << endl;
+                return 1;
+            }
+            cout << setw(40) << left << stats.algorithm << right << fixed << setprecision(2) << setw(8)
+                 << (double)compares / (double)adaptive_n << " cmp/elem  " << defaultfloat;
+            bench::printStats(stats);
+            csv.write(stats);
+        }
     }
 
-    csv.close();
-    cout << "\nResults appended to benchmark_results.csv" << endl;
+    cout << "\nResults appended to " << csv.path() << endl;
 
     return 0;
 }
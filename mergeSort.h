@@ -0,0 +1,456 @@
+// ===================================================================
+//                       MERGE SORT ALGORITHMS
+// ===================================================================
+//
+// Merge sort kernels shared by mergeSort.cpp and the other programs
+// that need a stable O(n log n) sort.
+//
+// Key Notes:
+// - mergeSort() is the classic top-down version: every merge()
+//   copies both halves into two new vectors.
+// - parallelMergeSort() allocates ONE scratch buffer of n elements up
+//   front and ping-pongs between it and the array, so no merge ever
+//   allocates. The two halves are sorted as tasks on a work-stealing
+//   ThreadPool, and the large merges near the top of the recursion are
+//   themselves split across threads by co-ranking. Ranges below a
+//   small cutoff are finished by smallSort() (see smallSort.h).
+// - adaptiveMergeSort() follows the input instead of the midpoints
+//   (powersort, the TimSort successor used by CPython):
+//     * it cuts the array into its natural ascending runs, reversing
+//       strictly descending ones, and extends runs shorter than 32-64
+//       elements by binary insertion sort,
+//     * runs are merged in the order of a nearly balanced merge tree
+//       over their positions (powersort's run stack policy),
+//     * a merge skips what is already in place at both ends, buffers
+//       only the shorter run, and gallops (exponential search) through
+//       long stretches taken from one side.
+//   Sorted or reversed input costs n - 1 compares and no merge; input
+//   made of k runs costs O(n log k).
+// - All three versions are stable.
+// - All are templates over the element type, a comparator and a
+//   projection (see ordering.h), with 64-bit indices.
+//   parallelMergeSort() also takes a contiguous iterator range
+//   (vector, array, raw pointers), mergeSort() and adaptiveMergeSort()
+//   any random access range:
+//       parallelMergeSort(v.begin(), v.end(), pool, std::greater<>());
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "ordering.h"   // Identity, projectedLess()
+#include "smallSort.h"  // smallSort(), smallSortCutoff()
+#include "threadPool.h"
+
+// ===================================================================
+//                      CLASSIC MERGE SORT
+// ===================================================================
+
+template <class RandomIt, class Less>
+inline void merge(RandomIt arr, ptrdiff_t left, ptrdiff_t mid, ptrdiff_t right, Less less) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    ptrdiff_t n1 = mid - left + 1;
+    ptrdiff_t n2 = right - mid;
+
+    std::vector<T> L(arr + left, arr + mid + 1), R(arr + mid + 1, arr + right + 1);
+
+    ptrdiff_t i = 0, j = 0, k = left;
+    while (i < n1 && j < n2) {
+        if (!less(R[j], L[i])) arr[k++] = std::move(L[i++]);
+        else arr[k++] = std::move(R[j++]);
+    }
+
+    while (i < n1) arr[k++] = std::move(L[i++]);
+    while (j < n2) arr[k++] = std::move(R[j++]);
+}
+
+/**
+ * @brief Classic top-down merge sort of [first, last).
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline void mergeSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    ptrdiff_t n = last - first;
+    if (n < 2) return;
+
+    ptrdiff_t mid = (n - 1) / 2;
+    mergeSort(first, first + mid + 1, comp, proj);
+    mergeSort(first + mid + 1, last, comp, proj);
+    ::merge(first, 0, mid, n - 1, projectedLess(comp, proj));
+}
+
+/**
+ * @brief Classic top-down merge sort of arr[left, right].
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class T, class Compare = std::less<>, class Proj = Identity>
+inline void mergeSort(std::vector<T>& arr, ptrdiff_t left, ptrdiff_t right, Compare comp = {}, Proj proj = {}) {
+    if (left >= right) return;
+    mergeSort(arr.begin() + left, arr.begin() + right + 1, comp, proj);
+}
+
+// ===================================================================
+//                     PARALLEL MERGE SORT
+// ===================================================================
+
+namespace mergesort_detail {
+
+// Below this many elements a range is sorted by a single thread.
+constexpr size_t kTaskGrain = 1 << 14;
+// Merges producing at least this many elements are split across threads.
+constexpr size_t kParallelMergeGrain = 1 << 16;
+/**
+ * @brief Sequential stable merge of a[0,na) and b[0,nb) into out.
+ */
+template <class T, class Less>
+inline void mergeRuns(T* a, size_t na, T* b, size_t nb, T* out, Less less) {
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        // Branch-free select; ties take from the left run (stable).
+        bool takeB = less(b[j], a[i]);
+        *out++ = std::move(takeB ? b[j] : a[i]);
+        j += takeB;
+        i += !takeB;
+    }
+    out = std::move(a + i, a + na, out);
+    std::move(b + j, b + nb, out);
+}
+
+/**
+ * @brief Co-rank: how many of the first @p k merged outputs come from a.
+ *
+ * Returns the i (with j = k - i) that a stable merge of a and b would
+ * have reached after writing k elements, found by binary search.
+ */
+template <class T, class Less>
+inline size_t coRank(size_t k, const T* a, size_t na, const T* b, size_t nb, Less less) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = std::min(k, na);
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+        // a[i] still belongs before b[j-1] => more than i come from a.
+        if (j > 0 && !less(b[j - 1], a[i])) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+/**
+ * @brief Stable merge split into independent output chunks by co-ranking.
+ */
+template <class T, class Less>
+inline void parallelMerge(ThreadPool& pool, T* a, size_t na, T* b, size_t nb, T* out, Less less) {
+    size_t total = na + nb;
+    if (pool.size() == 1 || total < kParallelMergeGrain) {
+        mergeRuns(a, na, b, nb, out, less);
+        return;
+    }
+    pool.parallelFor(0, total, kParallelMergeGrain / 2, [&](size_t lo, size_t hi) {
+        size_t ilo = coRank(lo, a, na, b, nb, less), jlo = lo - ilo;
+        size_t ihi = coRank(hi, a, na, b, nb, less), jhi = hi - ihi;
+        mergeRuns(a + ilo, ihi - ilo, b + jlo, jhi - jlo, out + lo, less);
+    });
+}
+
+/**
+ * @brief Sorts src[0,n). The result ends up in src when @p intoSrc is
+ *        true, otherwise in dst. src and dst are the two ping-pong
+ *        buffers; each level writes into the one the level above reads.
+ */
+template <class T, class Less>
+inline void sortPingPong(ThreadPool& pool, T* src, T* dst, size_t n, bool intoSrc, Less less) {
+    if ((ptrdiff_t)n <= smallSortCutoff<T*, Less>()) {
+        smallSort(src, (ptrdiff_t)n, less);
+        if (!intoSrc) std::move(src, src + n, dst);
+        return;
+    }
+
+    size_t half = n / 2;
+    // Children leave their halves in the buffer this level merges FROM.
+    if (n >= kTaskGrain && pool.size() > 1) {
+        ThreadPool::TaskGroup group(pool);
+        group.run([&] { sortPingPong(pool, src, dst, half, !intoSrc, less); });
+        sortPingPong(pool, src + half, dst + half, n - half, !intoSrc, less);
+        group.wait();
+    } else {
+        sortPingPong(pool, src, dst, half, !intoSrc, less);
+        sortPingPong(pool, src + half, dst + half, n - half, !intoSrc, less);
+    }
+
+    T* from = intoSrc ? dst : src;
+    T* to = intoSrc ? src : dst;
+    parallelMerge(pool, from, half, from + half, n - half, to, less);
+}
+
+}  // namespace mergesort_detail
+
+/**
+ * @brief Parallel stable merge sort of the contiguous range [first, last).
+ *
+ * @param pool Threads to use; ThreadPool(1) gives the sequential
+ *             ping-pong version with the same single scratch buffer.
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class ContiguousIt, class Compare = std::less<>, class Proj = Identity>
+inline void parallelMergeSort(ContiguousIt first, ContiguousIt last, ThreadPool& pool, Compare comp = {},
+                              Proj proj = {}) {
+    using T = typename std::iterator_traits<ContiguousIt>::value_type;
+    size_t n = (size_t)(last - first);
+    if (n < 2) return;
+    std::vector<T> scratch(n);
+    mergesort_detail::sortPingPong(pool, &*first, scratch.data(), n, true, projectedLess(comp, proj));
+}
+
+/**
+ * @brief Parallel stable merge sort.
+ *
+ * @param arr  The vector to sort in place.
+ * @param pool Threads to use; ThreadPool(1) gives the sequential
+ *             ping-pong version with the same single scratch buffer.
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class T, class Compare = std::less<>, class Proj = Identity>
+inline void parallelMergeSort(std::vector<T>& arr, ThreadPool& pool, Compare comp = {}, Proj proj = {}) {
+    parallelMergeSort(arr.begin(), arr.end(), pool, comp, proj);
+}
+
+// ===================================================================
+//                 ADAPTIVE MERGE SORT (POWERSORT)
+// ===================================================================
+
+namespace mergesort_detail {
+
+// Natural runs shorter than minRunLength(n) (32 ... 64) are extended
+// to it by binary insertion sort; smaller arrays are sorted that way.
+constexpr size_t kMinMerge = 64;
+// Wins in a row by one run that switch a merge to galloping.
+constexpr size_t kMinGallop = 7;
+
+inline size_t minRunLength(size_t n) {
+    size_t odd = 0;
+    while (n >= kMinMerge) {
+        odd |= n & 1;
+        n >>= 1;
+    }
+    return n + odd;
+}
+
+/**
+ * @brief Length of the natural run at the front of [first, last). A
+ *        strictly descending run is reversed in place (strictly, so
+ *        equal elements never swap: still stable).
+ */
+template <class It, class Less>
+inline size_t countRunAndMakeAscending(It first, It last, Less less) {
+    It run = first + 1;
+    if (run == last) return 1;
+    if (less(*run, *first)) {
+        while (++run != last && less(*run, *(run - 1))) {}
+        std::reverse(first, run);
+    } else {
+        while (++run != last && !less(*run, *(run - 1))) {}
+    }
+    return (size_t)(run - first);
+}
+
+/**
+ * @brief Sorts first[0, n) whose first @p sorted elements are already
+ *        in order: the others are inserted after a binary search.
+ */
+template <class It, class Less>
+inline void binaryInsertionSort(It first, size_t n, size_t sorted, Less less) {
+    for (size_t i = std::max<size_t>(sorted, 1); i < n; ++i) {
+        auto value = std::move(first[i]);
+        // Branch-free upper bound (after equal keys: stable).
+        It pos = first;
+        for (size_t len = i; len > 1; len -= len / 2) pos = less(value, pos[len / 2]) ? pos : pos + len / 2;
+        pos += !less(value, *pos);
+        std::move_backward(pos, first + i, first + i + 1);
+        *pos = std::move(value);
+    }
+}
+
+/**
+ * @brief How many leading elements of base[0, len) go before key:
+ *        those < key (strict) or <= key (!strict). Exponential search
+ *        from the front, then binary search: O(log answer) compares.
+ */
+template <bool strict, class It, class T, class Less>
+inline size_t gallop(const T& key, It base, size_t len, Less less) {
+    auto before = [&](const auto& x) { return strict ? less(x, key) : !less(key, x); };
+    size_t lo = 0, step = 1;
+    while (lo + step <= len && before(base[lo + step - 1])) {
+        lo += step;
+        step *= 2;
+    }
+    size_t hi = std::min(len, lo + step - 1);
+    return (size_t)(std::partition_point(base + lo, base + hi, before) - base);
+}
+
+/**
+ * @brief Stable merge of the adjacent runs a[0, na) and a[na, na + nb)
+ *        with the left run moved out to buf. Elements are taken one at
+ *        a time until one run wins minGallop times in a row, then whole
+ *        stretches are found by gallop() for as long as that pays off.
+ */
+template <class It, class T, class Less>
+inline void mergeLo(It a, size_t na, size_t nb, T* buf, Less less, size_t& minGallop) {
+    std::move(a, a + na, buf);
+    It b = a + na, out = a;
+    size_t i = 0, j = 0, streak = 0;  // streak: wins in a row by one run
+    bool lastB = false;
+    while (i < na && j < nb) {
+        if (streak < minGallop) {
+            // Branch-free select, as in mergeRuns(); neither run can
+            // run out within `steps` steps.
+            for (size_t steps = std::min(na - i, nb - j); steps > 0 && streak < minGallop; --steps) {
+                bool takeB = less(b[j], buf[i]);
+                *out++ = std::move(takeB ? b[j] : buf[i]);
+                j += takeB;
+                i += !takeB;
+                streak = takeB == lastB ? streak + 1 : 1;
+                lastB = takeB;
+            }
+            continue;
+        }
+        while (i < na && j < nb) {
+            size_t takeA = gallop<false>(b[j], buf + i, na - i, less);
+            out = std::move(buf + i, buf + i + takeA, out);
+            i += takeA;
+            if (i == na) break;
+            size_t takeB = gallop<true>(buf[i], b + j, nb - j, less);
+            out = std::move(b + j, b + j + takeB, out);
+            j += takeB;
+            // Short stretches: galloping costs more than it saves.
+            if (takeA < kMinGallop && takeB < kMinGallop) {
+                minGallop += 2;
+                break;
+            }
+            if (minGallop > 1) --minGallop;
+        }
+        streak = 0;
+    }
+    std::move(buf + i, buf + na, out);  // what is left of b is already in place
+}
+
+/**
+ * @brief Merges the adjacent sorted runs first[0, na) and
+ *        first[na, na + nb) in place, using buf as scratch for the
+ *        shorter of the two.
+ */
+template <class It, class T, class Less>
+inline void mergeAdjacent(It first, size_t na, size_t nb, std::vector<T>& buf, Less less, size_t& minGallop) {
+    // Elements already in their final place are not touched: the
+    // front of the left run that is <= the right run's first element,
+    // and the back of the right run that is >= the left run's last one.
+    size_t skip = gallop<false>(first[na], first, na, less);
+    first += skip;
+    na -= skip;
+    if (na == 0) return;
+    nb = gallop<true>(first[na - 1], first + na, nb, less);
+    if (nb == 0) return;
+
+    if (buf.size() < std::min(na, nb)) buf.resize(std::min(na, nb));
+    if (na <= nb) {
+        mergeLo(first, na, nb, buf.data(), less, minGallop);
+    } else {
+        // Right run shorter: the same merge walked from the back, with
+        // the comparator flipped so ties still keep their order.
+        auto flipped = [&](const auto& x, const auto& y) { return less(y, x); };
+        mergeLo(std::make_reverse_iterator(first + na + nb), nb, na, buf.data(), flipped, minGallop);
+    }
+}
+
+/**
+ * @brief Powersort merge priority of the boundary between the runs
+ *        [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2) of an n-element
+ *        array: the depth of the boundary between their midpoints in
+ *        the perfectly balanced merge tree over [0, n).
+ */
+inline int nodePower(size_t s1, size_t n1, size_t n2, size_t n) {
+    size_t a = 2 * s1 + n1;  // twice the first midpoint
+    size_t b = a + n1 + n2;  // twice the second midpoint
+    int power = 0;
+    while (true) {
+        ++power;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+template <class It, class Less>
+inline void adaptiveSort(It first, size_t n, Less less) {
+    using T = typename std::iterator_traits<It>::value_type;
+    struct Run {
+        size_t start, length;
+        int power;  // of the boundary with the run below it on the stack
+    };
+    std::vector<Run> stack;
+    std::vector<T> buf;
+    size_t minGallop = kMinGallop;
+    size_t minRun = minRunLength(n);
+
+    auto mergeTop = [&] {
+        Run right = stack.back();
+        stack.pop_back();
+        Run& left = stack.back();
+        mergeAdjacent(first + left.start, left.length, right.length, buf, less, minGallop);
+        left.length += right.length;
+    };
+
+    for (size_t start = 0; start < n;) {
+        size_t length = countRunAndMakeAscending(first + start, first + n, less);
+        if (length < minRun) {
+            size_t forced = std::min(minRun, n - start);
+            binaryInsertionSort(first + start, forced, length, less);
+            length = forced;
+        }
+        // Runs whose boundary is deeper than the new one are merged
+        // first: the merge tree stays close to the balanced one.
+        int power = 0;
+        if (!stack.empty()) {
+            power = nodePower(stack.back().start, stack.back().length, length, n);
+            while (stack.size() > 1 && stack.back().power > power) mergeTop();
+        }
+        stack.push_back({start, length, power});
+        start += length;
+    }
+    while (stack.size() > 1) mergeTop();
+}
+
+}  // namespace mergesort_detail
+
+/**
+ * @brief Adaptive stable merge sort (powersort) of [first, last): O(n)
+ *        on sorted or reversed input, O(n log n) in the worst case.
+ *
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline void adaptiveMergeSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    size_t n = (size_t)(last - first);
+    if (n < 2) return;
+    mergesort_detail::adaptiveSort(first, n, projectedLess(comp, proj));
+}
+
+/**
+ * @brief Adaptive stable merge sort (powersort) of a vector.
+ */
+template <class T, class Compare = std::less<>, class Proj = Identity>
+inline void adaptiveMergeSort(std::vector<T>& arr, Compare comp = {}, Proj proj = {}) {
+    adaptiveMergeSort(arr.begin(), arr.end(), comp, proj);
+}
@@ -15,28 +15,11 @@
 // ===================================================================
 
 #include <bits/stdc++.h>
-#include <fstream>   // For CSV output
+#include "benchmark.h"  // Shared timing harness + CSV writer
+#include "fibonacci.h"  // fibRecursive()
 using namespace std;
 using namespace std::chrono;
 
-// ===================================================================
-//                NAIVE RECURSIVE FIBONACCI
-// ===================================================================
-
-/**
- * @brief Naive recursive Fibonacci implementation.
- *
- * @param n The Fibonacci index.
- * @return The nth Fibonacci number.
- *
- * Time Complexity: O(2^n)
- * Space Complexity: O(n) due to recursion depth.
- */
-long long fibRecursive(int n) {
-    if (n <= 1) return n;
-    return fibRecursive(n - 1) + fibRecursive(n - 2);
-}
-
 // ===================================================================
 //                          MAIN FUNCTION
 // ===================================================================
@@ -45,32 +28,39 @@ int main() {
     // Test set chosen carefully (don’t go too high!)
     vector<int> test_n = {1, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50};
 
-    // Open CSV file for appending results
-    ofstream csv("benchmark_results.csv", ios::app);
+    // Shared CSV file; header is only written once, when the file is new
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
 
-    // Write a header section for clarity
-    csv << "\nAlgorithm,InputSize,Time_ns\n";
+    // Large n take seconds per call: skip warmup and stop sampling once
+    // the time budget for this n is used up (at least one sample is kept).
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 10;
+    cfg.maxTotalNs = 3e9;
 
     cout << "--- Recursive Fibonacci Benchmark ---" << endl;
     cout << "(Exponential runtime, safe up to n=50)\n" << endl;
 
     // Run benchmark for each n
     for (int n : test_n) {
-        auto start = high_resolution_clock::now();
-        fibRecursive(n);  // Compute nth Fibonacci number
-        auto end = high_resolution_clock::now();
+        if (n >= 40) cfg.warmupSamples = 0;
 
-        long long duration = duration_cast<nanoseconds>(end - start).count();
+        bench::Stats stats = bench::measure("RecursiveFibonacci", n, [&] {
+            bench::doNotOptimize(fibRecursive(n));  // Compute nth Fibonacci number
+        }, cfg);
 
         // Print to console
-        cout << "n=" << n << " | Time = " << duration << " ns" << endl;
+        bench::printStats(stats);
 
         // Save to CSV
-        csv << "RecursiveFibonacci," << n << "," << duration << "\n";
+        csv.write(stats);
     }
 
-    csv.close();
-    cout << "\nResults appended to benchmark_results.csv" << endl;
+    cout << "\nResults appended to " << csv.path() << endl;
 
     return 0;
 }
@@ -0,0 +1,106 @@
+// ===================================================================
+//                     NODE POOL ALLOCATOR
+// ===================================================================
+//
+// Fixed-size object pool for the nodes of linked structures (see
+// bPlusTree.h). Nodes are carved out of large chunks, and freed nodes
+// go onto a free list that the next allocation takes from first.
+//
+// Usage:
+//   NodePool<Node> pool;
+//   Node* n = pool.create();
+//   pool.destroy(n);
+//
+// Key Notes:
+// - One general-purpose malloc per chunk instead of per node: no
+//   per-node header, no lock, and nodes allocated together sit next
+//   to each other in memory.
+// - Chunks are aligned to alignof(T), so a T declared alignas(64)
+//   always starts on a cache line.
+// - Memory is only returned to the system when the pool is destroyed;
+//   reset() makes every node free again but keeps the chunks, so
+//   rebuilding a structure does not touch the system allocator.
+// - T must be trivially destructible: reset() and the destructor drop
+//   live nodes without running their destructors.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+
+template <class T>
+class NodePool {
+    static_assert(std::is_trivially_destructible_v<T>, "NodePool drops nodes without destroying them");
+
+public:
+    explicit NodePool(size_t nodesPerChunk = 4096) : nodesPerChunk_(std::max<size_t>(1, nodesPerChunk)) {}
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        for (T* chunk : chunks_) ::operator delete(chunk, std::align_val_t(alignof(T)));
+    }
+
+    /**
+     * @brief Constructs a T in a free slot.
+     */
+    template <class... Args>
+    T* create(Args&&... args) {
+        void* slot;
+        if (freeList_) {
+            slot = freeList_;
+            freeList_ = freeList_->next;
+        } else {
+            if (chunk_ == chunks_.size()) {
+                chunks_.push_back(static_cast<T*>(
+                    ::operator new(nodesPerChunk_ * sizeof(T), std::align_val_t(alignof(T)))));
+            }
+            slot = chunks_[chunk_] + used_;
+            if (++used_ == nodesPerChunk_) {
+                ++chunk_;
+                used_ = 0;
+            }
+        }
+        ++live_;
+        return new (slot) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Returns a node to the pool.
+     */
+    void destroy(T* node) {
+        node->~T();
+        FreeSlot* slot = reinterpret_cast<FreeSlot*>(node);
+        slot->next = freeList_;
+        freeList_ = slot;
+        --live_;
+    }
+
+    /**
+     * @brief Frees every node at once; the chunks are kept for reuse.
+     */
+    void reset() {
+        freeList_ = nullptr;
+        chunk_ = used_ = live_ = 0;
+    }
+
+    size_t liveNodes() const { return live_; }
+
+    /**
+     * @brief Bytes held by the pool (live, free and never used slots).
+     */
+    size_t capacityBytes() const { return chunks_.size() * nodesPerChunk_ * sizeof(T); }
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+    static_assert(sizeof(T) >= sizeof(FreeSlot), "nodes must be able to hold a free-list link");
+
+    size_t nodesPerChunk_;
+    std::vector<T*> chunks_;
+    size_t chunk_ = 0, used_ = 0;  // next never-used slot: chunks_[chunk_][used_]
+    size_t live_ = 0;
+    FreeSlot* freeList_ = nullptr;
+};
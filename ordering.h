@@ -0,0 +1,57 @@
+// ===================================================================
+//                 COMPARATORS & PROJECTIONS FOR KERNELS
+// ===================================================================
+//
+// Shared vocabulary of the templated sort / search kernels
+// (quickSort.h, mergeSort.h, binarySearch.h, linearSearch.h,
+// indirectSort.h).
+//
+// Every kernel takes a COMPARATOR and a PROJECTION, like the C++20
+// ranges algorithms:
+//   comp(proj(a), proj(b))   "a goes before b"
+// The projection picks the key out of an element (a record field, the
+// absolute value, ...); Identity uses the element itself.
+//
+// Key Notes:
+// - Both are template parameters taken BY VALUE, so the call is
+//   resolved at compile time and inlined; std::less<> on ints compiles
+//   to the same single compare as a hand-written int kernel. Passing a
+//   function pointer would still work, but without that inlining.
+// - Comparators must be strict weak orderings; equality is derived as
+//   !comp(a, b) && !comp(b, a).
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+
+/**
+ * @brief Projection that returns its argument unchanged.
+ */
+struct Identity {
+    template <class T>
+    constexpr T&& operator()(T&& value) const noexcept {
+        return std::forward<T>(value);
+    }
+};
+
+/**
+ * @brief Folds a comparator and a projection into one binary
+ *        predicate on elements: less(a, b) = comp(proj(a), proj(b)).
+ */
+template <class Compare, class Proj>
+struct ProjectedLess {
+    Compare comp;
+    Proj proj;
+
+    template <class A, class B>
+    constexpr bool operator()(const A& a, const B& b) const {
+        return comp(std::invoke(proj, a), std::invoke(proj, b));
+    }
+};
+
+template <class Compare, class Proj>
+constexpr ProjectedLess<Compare, Proj> projectedLess(Compare comp, Proj proj) {
+    return {std::move(comp), std::move(proj)};
+}
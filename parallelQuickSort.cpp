@@ -0,0 +1,134 @@
+// ===================================================================
+//             PARALLEL QUICK SORT SCALING BENCHMARK PROGRAM
+// ===================================================================
+//
+// Strong scaling of parallelQuickSort() (quickSort.h) on one large
+// array of random ints: the same n on 1, 2, 4, ... threads, against
+// the serial introQuickSort() and parallelMergeSort() (mergeSort.h)
+// on the same thread counts.
+//
+// Usage: ./parallelQuickSort [N]     (default N = 1000000000)
+//
+// Key Notes:
+// - Only ONE array of n ints is kept: every sample regenerates the
+//   input in place (untimed, see generateUniformBlock()), and the
+//   result is checked by sortedness plus an order-independent hash of
+//   the input. parallelMergeSort() needs a second n-element buffer, so
+//   the whole run needs 8 bytes per element (8 GB for the default).
+// - If that does not fit in 3/4 of the physical memory, n is halved
+//   until it does, and the reduced n is printed.
+// - Speedups are reported against the serial introQuickSort() and
+//   against the same sort on 1 thread.
+//
+// Build: g++ -O2 -pthread parallelQuickSort.cpp -o parallelQuickSort
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include <unistd.h>
+#include "benchmark.h"         // Shared timing harness + CSV writer
+#include "datasetGenerator.h"  // generateUniformBlock()
+#include "mergeSort.h"         // parallelMergeSort()
+#include "quickSort.h"         // introQuickSort(), parallelQuickSort()
+using namespace std;
+
+/**
+ * @brief Order-independent hash of a multiset of ints.
+ */
+uint64_t multisetHash(const vector<int>& v, ThreadPool& pool) {
+    atomic<uint64_t> hash{0};
+    pool.parallelFor(0, v.size(), 1 << 20, [&](size_t lo, size_t hi) {
+        uint64_t h = 0;
+        for (size_t i = lo; i < hi; ++i) h += dataset_detail::mix64((uint32_t)v[i]);
+        hash.fetch_add(h, memory_order_relaxed);
+    });
+    return hash.load();
+}
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? stoull(argv[1]) : 1000000000;
+    unsigned max_threads = max(1u, thread::hardware_concurrency());
+
+    double memory = (double)sysconf(_SC_PHYS_PAGES) * (double)sysconf(_SC_PAGESIZE);
+    size_t requested = n;
+    while (n > (1 << 20) && 8.0 * (double)n > memory * 0.75) n /= 2;
+    if (n != requested)
+        cout << "Note: n=" << requested << " needs " << 8 * requested / (1 << 20) << " MiB with the merge sort "
+             << "buffer, more than this machine has; using n=" << n << endl;
+
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    bench::Config cfg;
+    cfg.warmupSamples = 0;
+    cfg.samples = 3;
+    cfg.maxTotalNs = 60e9;
+
+    ThreadPool machine(max_threads);
+    DatasetSpec spec{Distribution::Uniform, n};
+    spec.maxValue = numeric_limits<int>::max();
+    vector<int> data(n);
+    auto regenerate = [&] { generateUniformBlock(spec, 0, n, data.data(), &machine); };
+    regenerate();
+    const uint64_t input_hash = multisetHash(data, machine);
+
+    auto check = [&](const string& name) {
+        bool ok = is_sorted(data.begin(), data.end()) && multisetHash(data, machine) == input_hash;
+        if (!ok) cerr << "Error: " << name << " produced a wrong result" << endl;
+        return ok;
+    };
+
+    cout << "--- Parallel Quick Sort Scaling (n=" << n << ", " << 4 * n / (1 << 20) << " MiB) ---\n" << endl;
+
+    bench::Stats serial = bench::measureWithSetup(
+        "IntroQuickSort", (long long)n, regenerate,
+        [&] { introQuickSort(data.begin(), data.end()); }, cfg);
+    if (!check(serial.algorithm)) return 1;
+    cout << left << setw(29) << "IntroQuickSort (serial)" << right;
+    bench::printStats(serial);
+    csv.write(serial);
+
+    // 1, 2, 4, ... and always the full machine
+    vector<unsigned> thread_counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    struct Sorter {
+        string name;
+        function<void(ThreadPool&)> sort;
+        double oneThreadNs = 0;
+    };
+    vector<Sorter> sorters = {
+        {"ParallelQuickSort", [&](ThreadPool& pool) { parallelQuickSort(data, pool); }},
+        {"ParallelMergeSort", [&](ThreadPool& pool) { parallelMergeSort(data, pool); }},
+    };
+
+    for (unsigned t : thread_counts) {
+        ThreadPool pool(t);
+        for (Sorter& sorter : sorters) {
+            bench::Stats stats = bench::measureWithSetup(
+                sorter.name + "_t" + to_string(t), (long long)n, regenerate,
+                [&] { sorter.sort(pool); }, cfg);
+            if (!check(stats.algorithm)) return 1;
+            if (t == 1) sorter.oneThreadNs = stats.medianNs;
+
+            cout << left << setw(18) << sorter.name << right << "threads=" << setw(3) << t << " ";
+            bench::printStats(stats);
+            cout << string(29, ' ') << "speedup vs serial = " << fixed << setprecision(2)
+                 << serial.medianNs / stats.medianNs << "x, vs 1 thread = "
+                 << sorter.oneThreadNs / stats.medianNs << "x" << defaultfloat << endl;
+            csv.write(stats);
+        }
+    }
+
+    cout << "\nResults appended to " << csv.path() << endl;
+
+    return 0;
+}
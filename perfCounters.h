@@ -0,0 +1,227 @@
+// ===================================================================
+//                  HARDWARE PERFORMANCE COUNTERS
+// ===================================================================
+//
+// Optional counter layer of the benchmark harness (benchmark.h): the
+// measure functions read these counters around every timed sample and
+// report them per kernel call next to the wall-clock times.
+//
+// Counted events:
+//   cycles, instructions (-> IPC), L1D read misses, LLC misses,
+//   branch misses, page faults
+//
+// Key Notes:
+// - Linux perf_event_open(), user space only (exclude_kernel), so it
+//   works with the default perf_event_paranoid = 2 and no root.
+// - All events are opened as ONE group, enabled / disabled / read with
+//   a single syscall each, so they cover exactly the same instructions.
+//   If the PMU multiplexes, values are scaled by enabled / running time.
+// - DEGRADES PER EVENT: an event the CPU / VM / container does not
+//   offer is simply missing (empty CSV column). Without any perf
+//   support at all, page faults still come from getrusage().
+// - Counts cover the CALLING THREAD only; work done on ThreadPool
+//   workers is not included.
+// - Set BENCH_COUNTERS=0 to switch the layer off.
+// - Other platforms compile to a stub with no counters.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include <sys/resource.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+enum class Counter { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses, PageFaults };
+constexpr size_t kCounterCount = 6;
+
+/**
+ * @brief Column name of a counter in benchmark_results.csv.
+ */
+inline const char* counterName(Counter c) {
+    static const char* const names[kCounterCount] = {"Cycles",     "Instructions",  "L1D_misses",
+                                                     "LLC_misses", "Branch_misses", "Page_faults"};
+    return names[(size_t)c];
+}
+
+/**
+ * @brief Counter readings; an event that could not be counted is
+ *        marked invalid rather than reported as zero.
+ */
+struct CounterValues {
+    std::array<double, kCounterCount> value{};
+    std::array<bool, kCounterCount> valid{};
+
+    bool has(Counter c) const { return valid[(size_t)c]; }
+    double operator[](Counter c) const { return value[(size_t)c]; }
+    bool any() const { return std::find(valid.begin(), valid.end(), true) != valid.end(); }
+
+    double ipc() const {
+        return has(Counter::Cycles) && has(Counter::Instructions) && value[(size_t)Counter::Cycles] > 0
+                   ? value[(size_t)Counter::Instructions] / value[(size_t)Counter::Cycles]
+                   : 0.0;
+    }
+
+    CounterValues& operator+=(const CounterValues& o) {
+        for (size_t i = 0; i < kCounterCount; ++i) {
+            value[i] += o.value[i];
+            valid[i] = valid[i] || o.valid[i];
+        }
+        return *this;
+    }
+
+    /**
+     * @brief The same readings divided by @p calls.
+     */
+    CounterValues perCall(double calls) const {
+        CounterValues r = *this;
+        if (calls > 0)
+            for (double& v : r.value) v /= calls;
+        return r;
+    }
+};
+
+/**
+ * @brief One group of counters for the calling thread.
+ *        start() / stop() bracket a region; stop() returns its counts.
+ */
+class PerfCounters {
+public:
+    PerfCounters() {
+        const char* env = std::getenv("BENCH_COUNTERS");
+        enabled_ = !(env && std::string(env) == "0");
+        if (enabled_) openEvents();
+    }
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (const Event& e : events_) ::close(e.fd);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool enabled() const { return enabled_; }
+
+    /**
+     * @brief Counters that are really backed by the hardware / kernel.
+     */
+    std::string description() const {
+        if (!enabled_) return "off (BENCH_COUNTERS=0)";
+        std::string s;
+        for (const Event& e : events_) s += std::string(s.empty() ? "" : ", ") + counterName(e.counter);
+        if (!hasFaultEvent_) s += std::string(s.empty() ? "" : ", ") + "Page_faults (getrusage)";
+        return s;
+    }
+
+    void start() {
+        if (!enabled_) return;
+        startFaults_ = rusageFaults();
+#if defined(__linux__)
+        if (!events_.empty()) {
+            ::ioctl(events_[0].fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(events_[0].fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    CounterValues stop() {
+        CounterValues r;
+        if (!enabled_) return r;
+#if defined(__linux__)
+        if (!events_.empty()) {
+            ::ioctl(events_[0].fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            // Layout for PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr].
+            uint64_t buffer[3 + kCounterCount];
+            ssize_t bytes = ::read(events_[0].fd, buffer, sizeof(buffer));
+            if (bytes >= (ssize_t)(3 * sizeof(uint64_t)) && buffer[0] == events_.size()) {
+                double scale = buffer[2] > 0 ? (double)buffer[1] / (double)buffer[2] : 0.0;
+                for (size_t i = 0; i < events_.size(); ++i) {
+                    size_t c = (size_t)events_[i].counter;
+                    r.value[c] = (double)buffer[3 + i] * scale;
+                    r.valid[c] = buffer[2] > 0;
+                }
+            }
+        }
+#endif
+        if (!hasFaultEvent_) {
+            r.value[(size_t)Counter::PageFaults] = (double)(rusageFaults() - startFaults_);
+            r.valid[(size_t)Counter::PageFaults] = true;
+        }
+        return r;
+    }
+
+private:
+    struct Event {
+        Counter counter;
+        int fd;
+    };
+
+    static long rusageFaults() {
+        struct rusage usage;
+#if defined(RUSAGE_THREAD)
+        if (::getrusage(RUSAGE_THREAD, &usage) != 0) return 0;
+#else
+        if (::getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#endif
+        return usage.ru_minflt + usage.ru_majflt;
+    }
+
+    void openEvents() {
+#if defined(__linux__)
+        auto cache = [](uint64_t id, uint64_t op, uint64_t result) { return id | (op << 8) | (result << 16); };
+        struct Spec {
+            Counter counter;
+            uint32_t type;
+            uint64_t config;
+        };
+        const Spec specs[kCounterCount] = {
+            {Counter::Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {Counter::Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {Counter::L1DMisses, PERF_TYPE_HW_CACHE,
+             cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+            {Counter::LLCMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {Counter::BranchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {Counter::PageFaults, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+        };
+        for (const Spec& spec : specs) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = spec.type;
+            attr.config = spec.config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            bool leader = events_.empty();
+            attr.disabled = leader ? 1 : 0;  // members follow the leader
+            int fd = (int)::syscall(SYS_perf_event_open, &attr, 0, -1, leader ? -1 : events_[0].fd, 0);
+            if (fd < 0) continue;  // not offered here: leave the column empty
+            events_.push_back({spec.counter, fd});
+            if (spec.counter == Counter::PageFaults) hasFaultEvent_ = true;
+        }
+#endif
+    }
+
+    bool enabled_ = false;
+    bool hasFaultEvent_ = false;
+    long startFaults_ = 0;
+    std::vector<Event> events_;
+};
+
+/**
+ * @brief The calling thread's counters, opened on first use.
+ */
+inline PerfCounters& threadCounters() {
+    thread_local PerfCounters counters;
+    return counters;
+}
+
+}  // namespace bench
@@ -0,0 +1,393 @@
+// ===================================================================
+//                       QUICK SORT ALGORITHMS
+// ===================================================================
+//
+// Quick sort kernels shared by quickSort.cpp and the other programs
+// that build on partitioning.
+//
+// Key Notes:
+// - quickSort() is the textbook version: Lomuto partition with the
+//   last element as pivot. It is O(n^2) and recurses n levels deep on
+//   sorted, reversed or duplicate-heavy input.
+// - introQuickSort() is the production version:
+//     * median-of-3 pivot (ninther for large ranges),
+//     * three-way partition, so runs of equal keys are finished in
+//       one pass instead of being split again and again,
+//     * smallSort() below a small cutoff (sorting networks for
+//       ints, see smallSort.h),
+//     * heapsort once the depth exceeds 2*log2(n), which bounds the
+//       worst case at O(n log n),
+//     * recursion only into the smaller side (stack depth O(log n)).
+// - Both are templates over the element type, a comparator and a
+//   projection (see ordering.h), with 64-bit indices, and also take
+//   any random-access iterator range:
+//       quickSort(a, a + n);
+//       introQuickSort(v.begin(), v.end(), std::greater<>());
+//       introQuickSort(recs.begin(), recs.end(), {}, &Record::key);
+// - parallelQuickSort() is introQuickSort() on a ThreadPool:
+//     * ranges of 2^20+ elements are partitioned by ALL threads: each
+//       one claims fixed-size blocks from both ends of the range and
+//       swaps misplaced elements between its left and right block
+//       until one of them is clean; the few half-done blocks left at
+//       the end (at most one per side and thread) are moved next to
+//       the unclaimed middle, which is then partitioned serially,
+//     * the two sides are sorted as tasks, down to a grain size below
+//       which a task runs introSortLoop() on its own,
+//     * in place: besides the O(log n) recursion it only keeps a
+//       pivot sample and one block index per thread and side.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "ordering.h"   // Identity, projectedLess()
+#include "smallSort.h"  // smallSort(), smallSortCutoff()
+#include "threadPool.h"
+
+// ===================================================================
+//                        QUICK SORT ALGORITHM
+// ===================================================================
+
+/**
+ * @brief Partition helper function for Quick Sort
+ * @param arr Start of the range to sort (vector iterator, pointer, ...)
+ * @param low Starting index
+ * @param high Ending index
+ * @param less Element order (comparator folded with projection)
+ * @return The partition index
+ */
+template <class RandomIt, class Less>
+inline ptrdiff_t partition(RandomIt arr, ptrdiff_t low, ptrdiff_t high, Less less) {
+    const auto& pivot = arr[high]; // choose last element as pivot
+    ptrdiff_t i = low - 1;
+
+    for (ptrdiff_t j = low; j < high; ++j) {
+        if (!less(pivot, arr[j])) {
+            ++i;
+            std::swap(arr[i], arr[j]);
+        }
+    }
+    std::swap(arr[i + 1], arr[high]);
+    return i + 1;
+}
+
+/**
+ * @brief Recursive Quick Sort of [first, last)
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline void quickSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    ptrdiff_t n = last - first;
+    if (n < 2) return;
+    ptrdiff_t pi = ::partition(first, 0, n - 1, projectedLess(comp, proj));
+    quickSort(first, first + pi, comp, proj);
+    quickSort(first + pi + 1, last, comp, proj);
+}
+
+/**
+ * @brief Recursive Quick Sort function
+ * @param arr Reference to the vector to sort
+ * @param low Starting index
+ * @param high Ending index
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class T, class Compare = std::less<>, class Proj = Identity>
+inline void quickSort(std::vector<T>& arr, ptrdiff_t low, ptrdiff_t high, Compare comp = {}, Proj proj = {}) {
+    if (low >= high) return;
+    quickSort(arr.begin() + low, arr.begin() + high + 1, comp, proj);
+}
+
+// ===================================================================
+//                    INTROSPECTIVE QUICK SORT
+// ===================================================================
+
+namespace quicksort_detail {
+
+// From this size on the pivot is Tukey's ninther instead of median-of-3.
+constexpr ptrdiff_t kNintherCutoff = 128;
+
+template <class It, class Less>
+inline void siftDown(It a, ptrdiff_t root, ptrdiff_t n, Less less) {
+    auto value = std::move(a[root]);
+    ptrdiff_t child;
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && less(a[child], a[child + 1])) ++child;
+        if (!less(value, a[child])) break;
+        a[root] = std::move(a[child]);
+        root = child;
+    }
+    a[root] = std::move(value);
+}
+
+/**
+ * @brief In-place heapsort; the O(n log n) fallback for bad pivots.
+ */
+template <class It, class Less>
+inline void heapSort(It a, ptrdiff_t n, Less less) {
+    for (ptrdiff_t i = n / 2 - 1; i >= 0; --i) siftDown(a, i, n, less);
+    for (ptrdiff_t end = n - 1; end > 0; --end) {
+        std::iter_swap(a, a + end);
+        siftDown(a, 0, end, less);
+    }
+}
+
+/**
+ * @brief max(min(x, y), min(max(x, y), z)), by reference.
+ */
+template <class T, class Less>
+inline const T& medianOf3(const T& x, const T& y, const T& z, Less less) {
+    bool yFirst = less(y, x);
+    const T& lo = yFirst ? y : x;
+    const T& hi = yFirst ? x : y;
+    const T& mid = less(z, hi) ? z : hi;
+    return less(lo, mid) ? mid : lo;
+}
+
+/**
+ * @brief Median of 3 for small ranges, ninther (median of three
+ *        medians of 3) for large ones.
+ */
+template <class It, class Less>
+inline const auto& choosePivot(It a, ptrdiff_t n, Less less) {
+    ptrdiff_t mid = n / 2, last = n - 1;
+    if (n < kNintherCutoff) return medianOf3(a[0], a[mid], a[last], less);
+
+    ptrdiff_t s = n / 8;
+    return medianOf3(medianOf3(a[0], a[s], a[2 * s], less),
+                     medianOf3(a[mid - s], a[mid], a[mid + s], less),
+                     medianOf3(a[last - 2 * s], a[last - s], a[last], less), less);
+}
+
+/**
+ * @brief Three-way (Dutch national flag) partition around @p pivot.
+ *
+ * Afterwards a[0,lt) < pivot, a[lt,gt) == pivot and a[gt,n) > pivot.
+ */
+template <class It, class T, class Less>
+inline void partition3(It a, ptrdiff_t n, const T& pivot, ptrdiff_t& lt, ptrdiff_t& gt, Less less) {
+    ptrdiff_t i = 0;
+    lt = 0;
+    gt = n;
+    while (i < gt) {
+        if (less(a[i], pivot)) std::iter_swap(a + lt++, a + i++);
+        else if (less(pivot, a[i])) std::iter_swap(a + i, a + --gt);
+        else ++i;
+    }
+}
+
+template <class It, class Less>
+inline void introSortLoop(It a, ptrdiff_t n, int depthLimit, Less less) {
+    while (n > smallSortCutoff<It, Less>()) {
+        if (depthLimit-- == 0) {
+            heapSort(a, n, less);
+            return;
+        }
+
+        // A copy: partitioning moves the element it was taken from.
+        const auto pivot = choosePivot(a, n, less);
+        ptrdiff_t lt, gt;
+        partition3(a, n, pivot, lt, gt, less);
+
+        // Recurse into the smaller side, loop on the larger one.
+        ptrdiff_t rightSize = n - gt;
+        if (lt < rightSize) {
+            introSortLoop(a, lt, depthLimit, less);
+            a += gt;
+            n = rightSize;
+        } else {
+            introSortLoop(a + gt, rightSize, depthLimit, less);
+            n = lt;
+        }
+    }
+    smallSort(a, n, less);
+}
+
+}  // namespace quicksort_detail
+
+/**
+ * @brief Introspective Quick Sort of [first, last): never quadratic,
+ *        O(log n) stack, not stable.
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline void introQuickSort(RandomIt first, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    ptrdiff_t n = last - first;
+    if (n < 2) return;
+    int depthLimit = 2 * (int)std::log2((double)n);
+    quicksort_detail::introSortLoop(first, n, depthLimit, projectedLess(comp, proj));
+}
+
+/**
+ * @brief Introspective Quick Sort: never quadratic, O(log n) stack.
+ * @param arr Reference to the vector to sort
+ * @param low Starting index
+ * @param high Ending index (inclusive, like quickSort())
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class T, class Compare = std::less<>, class Proj = Identity>
+inline void introQuickSort(std::vector<T>& arr, ptrdiff_t low, ptrdiff_t high, Compare comp = {}, Proj proj = {}) {
+    if (low >= high) return;
+    introQuickSort(arr.begin() + low, arr.begin() + high + 1, comp, proj);
+}
+
+// ===================================================================
+//                       PARALLEL QUICK SORT
+// ===================================================================
+
+namespace quicksort_detail {
+
+// Ranges of at least this many elements are partitioned by all threads.
+constexpr ptrdiff_t kParallelPartitionMin = 1 << 20;
+// Elements per block claimed by a partitioning thread.
+constexpr ptrdiff_t kPartitionBlock = 1 << 12;
+// Ranges below this size are sorted serially inside one task.
+constexpr ptrdiff_t kSortTaskGrain = 1 << 15;
+// Evenly spaced elements whose median is the parallel pivot.
+constexpr ptrdiff_t kPivotSample = 127;
+
+/**
+ * @brief Median of kPivotSample evenly spaced elements: a much better
+ *        split than the ninther, for a pass that costs a full sweep.
+ */
+template <class It, class Less>
+inline auto samplePivot(It a, ptrdiff_t n, Less less) {
+    std::array<ptrdiff_t, kPivotSample> index;
+    for (ptrdiff_t i = 0; i < kPivotSample; ++i) index[i] = i * (n - 1) / (kPivotSample - 1);
+    auto mid = index.begin() + kPivotSample / 2;
+    std::nth_element(index.begin(), mid, index.end(), [&](ptrdiff_t x, ptrdiff_t y) { return less(a[x], a[y]); });
+    return typename std::iterator_traits<It>::value_type(a[*mid]);
+}
+
+/**
+ * @brief Block-based parallel partition of a[0, n): moves the elements
+ *        with pred(x) to the front. Not stable.
+ * @return The number of elements with pred(x).
+ */
+template <class It, class Pred>
+inline ptrdiff_t parallelPartition(ThreadPool& pool, It a, ptrdiff_t n, Pred pred) {
+    const ptrdiff_t B = kPartitionBlock;
+    const ptrdiff_t blocks = n / B;
+
+    // A ticket from `claimed` guarantees that left and right blocks
+    // never overlap; the side counters then number the blocks.
+    std::atomic<ptrdiff_t> claimed{0}, leftBlocks{0}, rightBlocks{0};
+    auto claim = [&](std::atomic<ptrdiff_t>& side) -> ptrdiff_t {
+        if (claimed.fetch_add(1, std::memory_order_relaxed) >= blocks) return -1;
+        return side.fetch_add(1, std::memory_order_relaxed);
+    };
+    auto leftStart = [&](ptrdiff_t b) { return a + b * B; };
+    auto rightStart = [&](ptrdiff_t b) { return a + (n - (b + 1) * B); };
+
+    std::mutex mutex;
+    std::vector<ptrdiff_t> unfinishedLeft, unfinishedRight;
+
+    auto worker = [&] {
+        ptrdiff_t l = claim(leftBlocks), r = claim(rightBlocks);
+        ptrdiff_t li = 0, ri = 0;
+        while (l >= 0 && r >= 0) {
+            It L = leftStart(l), R = rightStart(r);
+            while (li < B && pred(L[li])) ++li;
+            while (ri < B && !pred(R[ri])) ++ri;
+            if (li == B) {
+                l = claim(leftBlocks);
+                li = 0;
+            } else if (ri == B) {
+                r = claim(rightBlocks);
+                ri = 0;
+            } else {
+                std::iter_swap(L + li++, R + ri++);
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (l >= 0) unfinishedLeft.push_back(l);
+        if (r >= 0) unfinishedRight.push_back(r);
+    };
+
+    {
+        ThreadPool::TaskGroup group(pool);
+        for (unsigned t = 1; t < pool.size(); ++t) group.run(worker);
+        worker();
+        group.wait();
+    }
+
+    // Swap the unfinished blocks of each side next to the unclaimed
+    // middle, over the clean blocks that were there.
+    auto gather = [&](std::vector<ptrdiff_t>& unfinished, ptrdiff_t count, auto start) {
+        std::sort(unfinished.begin(), unfinished.end());
+        ptrdiff_t firstSlot = count - (ptrdiff_t)unfinished.size();
+        size_t next = 0;
+        for (ptrdiff_t slot = firstSlot; slot < count; ++slot) {
+            if (std::binary_search(unfinished.begin(), unfinished.end(), slot)) continue;
+            It from = start(unfinished[next++]);
+            std::swap_ranges(from, from + B, start(slot));
+        }
+        return firstSlot;
+    };
+    ptrdiff_t lo = gather(unfinishedLeft, leftBlocks.load(), leftStart) * B;
+    ptrdiff_t hi = n - gather(unfinishedRight, rightBlocks.load(), rightStart) * B;
+
+    return std::partition(a + lo, a + hi, pred) - a;
+}
+
+template <class It, class Less>
+inline void parallelSortLoop(ThreadPool& pool, It a, ptrdiff_t n, int depthLimit, Less less) {
+    if (n < kSortTaskGrain) {
+        introSortLoop(a, n, depthLimit, less);
+        return;
+    }
+    if (depthLimit-- == 0) {
+        heapSort(a, n, less);
+        return;
+    }
+
+    ptrdiff_t lt, gt;
+    if (n >= kParallelPartitionMin) {
+        const auto pivot = samplePivot(a, n, less);
+        lt = parallelPartition(pool, a, n, [&](const auto& x) { return less(x, pivot); });
+        // A lopsided split usually means many copies of the pivot:
+        // split them off too, they are finished. This also guarantees
+        // progress when nothing is below the pivot.
+        gt = lt;
+        if (n - lt > n / 4 * 3)
+            gt += parallelPartition(pool, a + lt, n - lt, [&](const auto& x) { return !less(pivot, x); });
+    } else {
+        const auto pivot = choosePivot(a, n, less);
+        partition3(a, n, pivot, lt, gt, less);
+    }
+
+    ThreadPool::TaskGroup group(pool);
+    group.run([=, &pool] { parallelSortLoop(pool, a, lt, depthLimit, less); });
+    parallelSortLoop(pool, a + gt, n - gt, depthLimit, less);
+    group.wait();
+}
+
+}  // namespace quicksort_detail
+
+/**
+ * @brief Parallel introspective Quick Sort of [first, last): in place,
+ *        never quadratic, not stable.
+ * @param pool Threads to use; with ThreadPool(1) the same algorithm
+ *             runs on the caller alone.
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline void parallelQuickSort(RandomIt first, RandomIt last, ThreadPool& pool, Compare comp = {}, Proj proj = {}) {
+    ptrdiff_t n = last - first;
+    if (n < 2) return;
+    int depthLimit = 2 * (int)std::log2((double)n);
+    quicksort_detail::parallelSortLoop(pool, first, n, depthLimit, projectedLess(comp, proj));
+}
+
+/**
+ * @brief Parallel introspective Quick Sort of a whole vector.
+ */
+template <class T, class Compare = std::less<>, class Proj = Identity>
+inline void parallelQuickSort(std::vector<T>& arr, ThreadPool& pool, Compare comp = {}, Proj proj = {}) {
+    parallelQuickSort(arr.begin(), arr.end(), pool, comp, proj);
+}
@@ -0,0 +1,83 @@
+// ===================================================================
+//                    RADIX SORT BENCHMARK PROGRAM
+// ===================================================================
+//
+// This program benchmarks LSD Radix Sort against std::sort and the
+// quick sorts on arrays of different input sizes, and appends every
+// result to the shared benchmark_results.csv so the crossover point
+// can be plotted next to the other sorting algorithms.
+//
+// Key Notes:
+// - Radix sort does not compare keys; it is O(passes * n).
+// - For small n the fixed cost of the histograms dominates and the
+//   comparison sorts win; the table shows where radix sort overtakes.
+// - Each sample sorts a fresh copy of the same random input.
+//
+// Build: g++ -O2 -pthread radixSort.cpp -o radixSort
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"         // Shared timing harness + CSV writer
+#include "datasetGenerator.h"  // loadDataset(): seeded, cached inputs
+#include "quickSort.h"         // quickSort() and introQuickSort()
+#include "radixSort.h"         // radixSort()
+using namespace std;
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main() {
+    vector<int> n_values = {10, 100, 1000, 10000, 100000, 1000000, 10000000};
+
+    bench::ResultWriter csv; // Append mode
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    bench::Config cfg;
+    cfg.samples = 10;
+
+    ThreadPool pool;
+
+    cout << "--- Radix Sort vs. Comparison Sorts ---" << endl;
+    cout << "Each sample sorts a fresh copy of the same random input.\n" << endl;
+
+    for (int n : n_values) {
+        const vector<int> input = loadDataset({Distribution::Uniform, (size_t)n});
+        vector<int> expected = input;
+        sort(expected.begin(), expected.end());
+        vector<int> data;
+
+        auto run = [&](const string& name, auto&& sorter) {
+            bench::Stats stats = bench::measureWithSetup(
+                name, n, [&] { data = input; }, [&] { sorter(); }, cfg);
+            if (data != expected) {
+                cerr << "Error: " << name << " produced a wrong result" << endl;
+                exit(1);
+            }
+            cout << setw(20) << left << name << right;
+            bench::printStats(stats);
+            csv.write(stats);
+            return stats.medianNs;
+        };
+
+        double radix = run("RadixSort", [&] { radixSort(data); });
+        if (pool.size() > 1)
+            radix = min(radix, run("RadixSort_t" + to_string(pool.size()), [&] { radixSort(data, &pool); }));
+        double std_sort = run("StdSort", [&] { sort(data.begin(), data.end()); });
+        double quick = run("QuickSort", [&] { quickSort(data, 0, data.size() - 1); });
+        double intro = run("IntroQuickSort", [&] { introQuickSort(data, 0, data.size() - 1); });
+
+        cout << fixed << setprecision(2)
+             << "  radix speedup: " << std_sort / radix << "x vs std::sort, "
+             << quick / radix << "x vs quickSort, "
+             << intro / radix << "x vs introQuickSort\n" << defaultfloat << endl;
+    }
+
+    cout << "Results appended to " << csv.path() << endl;
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+// ===================================================================
+//                     LSD RADIX SORT (32-BIT KEYS)
+// ===================================================================
+//
+// Least-significant-digit radix sort for int keys, optionally carrying
+// a value array along with the keys.
+//
+// Key Notes:
+// - Keys are split into four 8-bit digits. ONE read of the input
+//   builds all four digit histograms at the same time.
+// - A pass whose digit is the same for every key (all counts in one
+//   bucket) is skipped. Our data lives in 0..100000, so the top digit
+//   is always constant and only 3 of the 4 passes run.
+// - Signed keys are handled by flipping the sign bit, which maps
+//   INT_MIN..INT_MAX onto 0..UINT_MAX in the same order.
+// - Each pass is a stable counting scatter, so the sort is stable and
+//   values travel with their keys.
+// - With a ThreadPool and a large n, every pass is split into one
+//   chunk per thread: each chunk counts its own digits, the counts are
+//   prefix-summed chunk by chunk, and all chunks scatter in parallel
+//   into disjoint, pre-computed output slots (still stable).
+// - Time complexity: O(passes * n), extra space: one n-element buffer
+//   for the keys (and one for the values).
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "threadPool.h"
+
+namespace radix_detail {
+
+constexpr int kDigitBits = 8;
+constexpr int kBuckets = 1 << kDigitBits;
+constexpr int kPasses = 32 / kDigitBits;
+// Below this many elements the passes run on one thread.
+constexpr size_t kParallelThreshold = 1 << 18;
+
+using Histogram = std::array<size_t, kBuckets>;
+
+// Placeholder value type for key-only sorts.
+struct NoValue {};
+
+inline uint32_t toKey(int x) {
+    return (uint32_t)x ^ 0x80000000u;
+}
+
+inline unsigned digitOf(int x, int pass) {
+    return (toKey(x) >> (pass * kDigitBits)) & (kBuckets - 1);
+}
+
+/**
+ * @brief Builds the histograms of every digit in a single read.
+ */
+inline void countAllDigits(const int* keys, size_t n, Histogram (&hist)[kPasses]) {
+    for (auto& h : hist) h.fill(0);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t k = toKey(keys[i]);
+        hist[0][k & 0xFF]++;
+        hist[1][(k >> 8) & 0xFF]++;
+        hist[2][(k >> 16) & 0xFF]++;
+        hist[3][k >> 24]++;
+    }
+}
+
+/**
+ * @brief Turns counts into exclusive prefix sums (bucket start offsets).
+ */
+inline void exclusiveScan(Histogram& h, size_t start = 0) {
+    size_t sum = start;
+    for (size_t& c : h) {
+        size_t count = c;
+        c = sum;
+        sum += count;
+    }
+}
+
+template <class Value>
+void scatter(const int* srcKeys, const Value* srcValues, int* dstKeys, Value* dstValues,
+             size_t begin, size_t end, int pass, Histogram& offsets) {
+    for (size_t i = begin; i < end; ++i) {
+        size_t pos = offsets[digitOf(srcKeys[i], pass)]++;
+        dstKeys[pos] = srcKeys[i];
+        if constexpr (!std::is_same<Value, NoValue>::value) dstValues[pos] = srcValues[i];
+    }
+}
+
+/**
+ * @brief One parallel pass: per-chunk counts, chunk-ordered offsets,
+ *        then all chunks scatter at once.
+ */
+template <class Value>
+void parallelPass(ThreadPool& pool, const int* srcKeys, const Value* srcValues, int* dstKeys,
+                  Value* dstValues, size_t n, int pass) {
+    size_t chunks = pool.size();
+    size_t step = (n + chunks - 1) / chunks;
+    std::vector<Histogram> offsets(chunks);
+
+    auto forEachChunk = [&](auto&& body) {
+        ThreadPool::TaskGroup group(pool);
+        for (size_t c = 1; c < chunks; ++c) group.run([&body, c] { body(c); });
+        body(0);
+        group.wait();
+    };
+
+    forEachChunk([&](size_t c) {
+        Histogram& h = offsets[c];
+        h.fill(0);
+        size_t end = std::min(n, (c + 1) * step);
+        for (size_t i = c * step; i < end; ++i) h[digitOf(srcKeys[i], pass)]++;
+    });
+
+    // Bucket-major, chunk-minor prefix sum keeps the scatter stable.
+    size_t sum = 0;
+    for (int d = 0; d < kBuckets; ++d) {
+        for (size_t c = 0; c < chunks; ++c) {
+            size_t count = offsets[c][d];
+            offsets[c][d] = sum;
+            sum += count;
+        }
+    }
+
+    forEachChunk([&](size_t c) {
+        size_t begin = std::min(n, c * step), end = std::min(n, (c + 1) * step);
+        scatter(srcKeys, srcValues, dstKeys, dstValues, begin, end, pass, offsets[c]);
+    });
+}
+
+template <class Value>
+void radixSortImpl(int* keys, Value* values, size_t n, ThreadPool* pool) {
+    if (n < 2) return;
+
+    Histogram hist[kPasses];
+    countAllDigits(keys, n, hist);
+
+    std::vector<int> keyBuffer(n);
+    std::vector<Value> valueBuffer(std::is_same<Value, NoValue>::value ? 0 : n);
+
+    int* srcKeys = keys;
+    int* dstKeys = keyBuffer.data();
+    Value* srcValues = values;
+    Value* dstValues = valueBuffer.data();
+
+    bool parallel = pool && pool->size() > 1 && n >= kParallelThreshold;
+
+    for (int pass = 0; pass < kPasses; ++pass) {
+        // Constant digit: this pass would not move anything.
+        if (hist[pass][digitOf(srcKeys[0], pass)] == n) continue;
+
+        if (parallel) {
+            parallelPass(*pool, srcKeys, srcValues, dstKeys, dstValues, n, pass);
+        } else {
+            exclusiveScan(hist[pass]);
+            scatter(srcKeys, srcValues, dstKeys, dstValues, 0, n, pass, hist[pass]);
+        }
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+    }
+
+    // An odd number of passes leaves the result in the buffers.
+    if (srcKeys != keys) {
+        std::copy(srcKeys, srcKeys + n, keys);
+        if constexpr (!std::is_same<Value, NoValue>::value) std::copy(srcValues, srcValues + n, values);
+    }
+}
+
+}  // namespace radix_detail
+
+/**
+ * @brief Sorts a vector of ints with LSD radix sort.
+ * @param arr  The vector to sort in place.
+ * @param pool Optional; large inputs scatter in parallel on it.
+ */
+inline void radixSort(std::vector<int>& arr, ThreadPool* pool = nullptr) {
+    radix_detail::radixSortImpl<radix_detail::NoValue>(arr.data(), nullptr, arr.size(), pool);
+}
+
+/**
+ * @brief Sorts key-value pairs by key (stable), moving values with keys.
+ * @param keys   The int keys; sorted in place.
+ * @param values One value per key; permuted exactly like the keys.
+ * @param pool   Optional; large inputs scatter in parallel on it.
+ */
+template <class Value>
+void radixSortPairs(std::vector<int>& keys, std::vector<Value>& values, ThreadPool* pool = nullptr) {
+    if (keys.size() != values.size())
+        throw std::invalid_argument("radixSortPairs: keys and values differ in size");
+    radix_detail::radixSortImpl<Value>(keys.data(), values.data(), keys.size(), pool);
+}
@@ -0,0 +1,203 @@
+// ===================================================================
+//                  CACHE-FRIENDLY STATIC SEARCH LAYOUTS
+// ===================================================================
+//
+// Static search indexes built ONCE from a sorted vector<int>. They
+// answer the same questions as binarySearch.h:
+//   find(target)       -> index in the sorted array, or -1
+//   lowerBound(target) -> index of the first element >= target, or n
+//
+// Key Notes:
+// - EytzingerIndex stores the keys in BFS order of the implicit binary
+//   search tree (root at 1, children of k at 2k and 2k+1). The top of
+//   the tree is packed into a few hot cache lines, the descent is
+//   branchless, and the node 4 levels below is prefetched on every
+//   step, so memory latency overlaps with the comparisons.
+// - STreeIndex is a static B+ tree with 16 keys (one cache line) per
+//   node: the leaves are the sorted array itself, padded to whole
+//   nodes, and the levels above hold separator keys. A node is
+//   searched with two AVX2 compares + popcount (scalar fallback
+//   without AVX2), so a lookup touches ~log17(n) cache lines instead
+//   of ~log2(n).
+// - Both indexes keep their own copy of the keys; memoryBytes() reports
+//   the footprint.
+// - Build with -march=native (or -mavx2) to enable the SIMD path.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "alignedAllocator.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// ===================================================================
+//                        EYTZINGER LAYOUT
+// ===================================================================
+
+class EytzingerIndex {
+public:
+    /**
+     * @brief Builds the layout from an already sorted vector.
+     */
+    explicit EytzingerIndex(const std::vector<int>& sorted)
+        : n_((int)sorted.size()), tree_(sorted.size() + 1), rank_(sorted.size() + 1) {
+        int next = 0;
+        build(sorted, 1, next);
+    }
+
+    /**
+     * @brief Index (in the sorted array) of the first element >= target,
+     *        or n if every element is smaller.
+     */
+    int lowerBound(int target) const {
+        size_t k = descend(target);
+        return k == 0 ? n_ : rank_[k];
+    }
+
+    /**
+     * @brief Index of target in the sorted array, or -1 if absent.
+     */
+    int find(int target) const {
+        size_t k = descend(target);
+        return (k != 0 && tree_[k] == target) ? rank_[k] : -1;
+    }
+
+    size_t size() const { return n_; }
+
+    size_t memoryBytes() const {
+        return tree_.size() * sizeof(int) + rank_.size() * sizeof(int);
+    }
+
+private:
+    // Recursive in-order fill: node k gets the next smallest key.
+    void build(const std::vector<int>& sorted, size_t k, int& next) {
+        if (k > (size_t)n_) return;
+        build(sorted, 2 * k, next);
+        tree_[k] = sorted[next];
+        rank_[k] = next++;
+        build(sorted, 2 * k + 1, next);
+    }
+
+    /**
+     * @brief Branchless descent; returns the Eytzinger index of the
+     *        lower bound, or 0 if there is none.
+     */
+    size_t descend(int target) const {
+        const int* t = tree_.data();
+        size_t k = 1;
+        while (k <= (size_t)n_) {
+            // 16 ints = 64 bytes: the 16 great-great-grandchildren of k
+            // share one cache line.
+            __builtin_prefetch(t + 16 * k);
+            k = 2 * k + (t[k] < target);
+        }
+        // Undo the right turns taken after the last left turn.
+        k >>= __builtin_ffsll(~k);
+        return k;
+    }
+
+    int n_;
+    std::vector<int, AlignedAllocator<int, 64>> tree_;  // 1-based
+    std::vector<int> rank_;                             // tree_[k] == sorted[rank_[k]]
+};
+
+// ===================================================================
+//                  S-TREE (STATIC B+ TREE) LAYOUT
+// ===================================================================
+
+class STreeIndex {
+public:
+    static constexpr int B = 16;  // keys per node = one 64-byte cache line
+
+    /**
+     * @brief Builds the layout from an already sorted vector.
+     */
+    explicit STreeIndex(const std::vector<int>& sorted) : n_((int)sorted.size()) {
+        height_ = height(n_);
+        // offset_[h] = first element of layer h (0 = leaves, height_-1 = root)
+        offset_.assign(height_ + 1, 0);
+        for (int h = 0, keys = n_; h < height_; ++h) {
+            offset_[h + 1] = offset_[h] + blocks(keys) * B;
+            keys = keysAbove(keys);
+        }
+        tree_.assign(offset_[height_], kInf);
+
+        std::copy(sorted.begin(), sorted.end(), tree_.begin());
+
+        // Separator j of a node = smallest key under its child j+1, i.e.
+        // the first key of that child's leftmost leaf.
+        for (int h = 1; h < height_; ++h) {
+            for (size_t i = 0; i < offset_[h + 1] - offset_[h]; ++i) {
+                size_t node = i / B, slot = i % B;
+                size_t leaf = node * (B + 1) + slot + 1;
+                for (int l = 1; l < h; ++l) leaf *= (B + 1);
+                tree_[offset_[h] + i] = leaf * B < (size_t)n_ ? tree_[leaf * B] : kInf;
+            }
+        }
+    }
+
+    /**
+     * @brief Index (in the sorted array) of the first element >= target,
+     *        or n if every element is smaller.
+     */
+    int lowerBound(int target) const {
+        if (n_ == 0) return 0;
+        // k is always a multiple of B: the first key of the current node.
+        size_t k = 0;
+        for (int h = height_ - 1; h > 0; --h) {
+            unsigned i = countLess(tree_.data() + offset_[h] + k, target);
+            k = k * (B + 1) + i * B;
+        }
+        size_t pos = k + countLess(tree_.data() + k, target);
+        return (int)std::min(pos, (size_t)n_);
+    }
+
+    /**
+     * @brief Index of target in the sorted array, or -1 if absent.
+     */
+    int find(int target) const {
+        int pos = lowerBound(target);
+        return (pos < n_ && tree_[pos] == target) ? pos : -1;
+    }
+
+    size_t size() const { return n_; }
+
+    size_t memoryBytes() const { return tree_.size() * sizeof(int); }
+
+private:
+    static constexpr int kInf = std::numeric_limits<int>::max();
+
+    static int blocks(int keys) { return (keys + B - 1) / B; }
+    // Keys needed in the layer above: one node per B+1 children.
+    static int keysAbove(int keys) { return (blocks(keys) + B) / (B + 1) * B; }
+    static int height(int keys) { return keys <= B ? 1 : 1 + height(keysAbove(keys)); }
+
+    /**
+     * @brief Number of keys in the 16-key node that are < target.
+     */
+    static unsigned countLess(const int* node, int target) {
+#ifdef __AVX2__
+        __m256i x = _mm256_set1_epi32(target);
+        __m256i a = _mm256_load_si256((const __m256i*)node);
+        __m256i b = _mm256_load_si256((const __m256i*)(node + 8));
+        __m256i lessA = _mm256_cmpgt_epi32(x, a);
+        __m256i lessB = _mm256_cmpgt_epi32(x, b);
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lessA)) |
+                        ((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lessB)) << 8);
+        return __builtin_popcount(mask);
+#else
+        unsigned count = 0;
+        for (int i = 0; i < B; ++i) count += node[i] < target;
+        return count;
+#endif
+    }
+
+    int n_;
+    int height_ = 1;
+    std::vector<size_t> offset_;
+    std::vector<int, AlignedAllocator<int, 64>> tree_;
+};
@@ -0,0 +1,225 @@
+// ===================================================================
+//              SELECTION / PERCENTILE / TOP-K BENCHMARK PROGRAM
+// ===================================================================
+//
+// Compares the selection routines of selection.h with the two ways of
+// getting an order statistic before them:
+//   * a full introQuickSort() and an index into the sorted array,
+//   * std::nth_element (and std::partial_sort for top-k).
+//
+// Usage: ./selection [N]     (default N = 10000000)
+//
+// Key Notes:
+// - Median: introSelect() on every input profile of datasetGenerator.h.
+//   None of these is a bad case for the median-of-3 / ninther pivots
+//   (on sorted and reversed input they pick the exact median); only an
+//   adversarial order such as a median-of-3 killer drives quickselect
+//   towards O(n^2), and that is what the median-of-medians fallback
+//   bounds at O(n). On the presorted profiles std::nth_element's
+//   branchy partition is perfectly predicted and wins; on random input
+//   the branch-free one does.
+// - Percentiles: p1 ... p99.9 (10 ranks) with one multiSelect() pass,
+//   one nth_element per rank, or one full sort.
+// - Top-k for k = 10, 1000, 100000: the TopK heap over the array as a
+//   stream, partial_sort, introSelect() + sort of the k, full sort.
+//   partial_sort is the same heap, kept in place; TopK is the one that
+//   also works when the data never is all in memory.
+// - Streaming top-k from an N-int file (the format of externalSort.h)
+//   in 64K-int blocks, against reading the whole file and selecting.
+// - Every answer is checked against the fully sorted array.
+//
+// Build: g++ -O2 -march=native selection.cpp -o selection
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"         // Shared timing harness + CSV writer
+#include "datasetGenerator.h"  // loadDataset() and the input profiles
+#include "quickSort.h"         // introQuickSort()
+#include "selection.h"         // introSelect(), multiSelect(), TopK
+using namespace std;
+
+void printRow(const bench::Stats& stats, bench::ResultWriter& csv) {
+    cout << setw(34) << left << stats.algorithm << right << fixed << setprecision(3) << setw(12)
+         << stats.medianNs / 1e6 << " ms" << defaultfloat << endl;
+    csv.write(stats);
+}
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? stoull(argv[1]) : 10000000;
+    if (n == 0) {
+        cerr << "Error: N must be positive" << endl;
+        return 1;
+    }
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 5;
+    vector<int> data;
+
+    // ---- median on every profile ----
+    cout << "--- Median of " << n << " ints (median time) ---" << endl;
+    for (Distribution distribution : allDistributions()) {
+        string profile = distributionName(distribution);
+        const vector<int> input = loadDataset({distribution, n});
+        vector<int> sorted = input;
+        sort(sorted.begin(), sorted.end());
+        size_t mid = n / 2;
+
+        cout << "\n" << profile << ":" << endl;
+        int answer = 0;
+        auto run = [&](const string& name, auto&& select) {
+            bench::Stats stats = bench::measureWithSetup(name + "_" + profile, (long long)n, [&] { data = input; },
+                                                         [&] { answer = select(); }, cfg);
+            if (answer != sorted[mid]) {
+                cerr << "Error: " << name << " gives the wrong median on " << profile << endl;
+                return false;
+            }
+            printRow(stats, csv);
+            return true;
+        };
+        if (!run("Median_FullSort", [&] {
+                introQuickSort(data.begin(), data.end());
+                return data[mid];
+            }) ||
+            !run("Median_StdNthElement", [&] {
+                nth_element(data.begin(), data.begin() + mid, data.end());
+                return data[mid];
+            }) ||
+            !run("Median_IntroSelect", [&] {
+                introSelect(data.begin(), data.begin() + mid, data.end());
+                return data[mid];
+            }))
+            return 1;
+    }
+
+    // ---- many percentiles at once ----
+    const vector<int> uniform = loadDataset({Distribution::Uniform, n});
+    vector<int> sorted = uniform;
+    sort(sorted.begin(), sorted.end());
+    const vector<double> ps = {1, 5, 10, 25, 50, 75, 90, 95, 99, 99.9};
+    vector<size_t> ranks;
+    vector<int> expected;
+    for (double p : ps) {
+        ranks.push_back(percentileRank(p, n));
+        expected.push_back(sorted[ranks.back()]);
+    }
+
+    cout << "\n--- " << ps.size() << " percentiles (p1 ... p99.9) of " << n << " uniform ints ---" << endl;
+    vector<int> values;
+    auto runPercentiles = [&](const string& name, auto&& kernel) {
+        bench::Stats stats = bench::measureWithSetup(name, (long long)n, [&] { data = uniform; },
+                                                     [&] { values = kernel(); }, cfg);
+        if (values != expected) {
+            cerr << "Error: " << name << " gives wrong percentiles" << endl;
+            return false;
+        }
+        printRow(stats, csv);
+        return true;
+    };
+    auto pick = [&] {
+        vector<int> out;
+        for (size_t r : ranks) out.push_back(data[r]);
+        return out;
+    };
+    if (!runPercentiles("Percentiles_FullSort", [&] {
+            introQuickSort(data.begin(), data.end());
+            return pick();
+        }) ||
+        !runPercentiles("Percentiles_StdNthElementEach", [&] {
+            for (size_t r : ranks) nth_element(data.begin(), data.begin() + r, data.end());
+            return pick();
+        }) ||
+        !runPercentiles("Percentiles_MultiSelect", [&] { return percentiles(data, ps); }))
+        return 1;
+
+    // ---- top-k ----
+    for (size_t k : {(size_t)10, (size_t)1000, (size_t)100000}) {
+        if (k > n) break;
+        vector<int> best(sorted.rbegin(), sorted.rbegin() + k);
+        cout << "\n--- Top " << k << " of " << n << " uniform ints (largest first) ---" << endl;
+        vector<int> top;
+        auto runTopK = [&](const string& name, auto&& kernel) {
+            bench::Stats stats = bench::measureWithSetup(name + "_k" + to_string(k), (long long)n,
+                                                         [&] { data = uniform; }, [&] { top = kernel(); }, cfg);
+            if (top != best) {
+                cerr << "Error: " << name << " gives a wrong top " << k << endl;
+                return false;
+            }
+            printRow(stats, csv);
+            return true;
+        };
+        if (!runTopK("TopK_FullSort", [&] {
+                introQuickSort(data.begin(), data.end(), greater<>());
+                return vector<int>(data.begin(), data.begin() + k);
+            }) ||
+            !runTopK("TopK_StdPartialSort", [&] {
+                partial_sort(data.begin(), data.begin() + k, data.end(), greater<>());
+                return vector<int>(data.begin(), data.begin() + k);
+            }) ||
+            !runTopK("TopK_IntroSelectThenSort", [&] {
+                introSelect(data.begin(), data.begin() + (k - 1), data.end(), greater<>());
+                introQuickSort(data.begin(), data.begin() + k, greater<>());
+                return vector<int>(data.begin(), data.begin() + k);
+            }) ||
+            !runTopK("TopK_StreamingHeap", [&] {
+                TopK<int> heap(k);
+                heap.push(data.begin(), data.end());
+                return heap.sorted();
+            }))
+            return 1;
+    }
+
+    // ---- top-k of a file, streamed in blocks ----
+    string path = (filesystem::path(datasetCacheDir()) / "selection_topk.bin").string();
+    {
+        filesystem::create_directories(datasetCacheDir());
+        ofstream out(path, ios::binary | ios::trunc);
+        out.write(reinterpret_cast<const char*>(uniform.data()), (streamsize)(n * sizeof(int)));
+        if (!out) {
+            cerr << "Error: could not write " << path << endl;
+            return 1;
+        }
+    }
+    size_t k = min<size_t>(1000, n);
+    vector<int> best(sorted.rbegin(), sorted.rbegin() + k);
+    cout << "\n--- Top " << k << " of a " << n * sizeof(int) / 1048576 << " MiB int file ---" << endl;
+    vector<int> top;
+    bench::Stats streamed = bench::measure("TopKFile_StreamingHeap", (long long)n, [&] {
+        topKOfFile(path, k, top);
+    }, cfg);
+    if (top != best) {
+        cerr << "Error: topKOfFile gives a wrong top " << k << endl;
+        return 1;
+    }
+    printRow(streamed, csv);
+    bench::Stats loaded = bench::measure("TopKFile_LoadThenSelect", (long long)n, [&] {
+        ifstream in(path, ios::binary);
+        vector<int> all(n);
+        in.read(reinterpret_cast<char*>(all.data()), (streamsize)(n * sizeof(int)));
+        introSelect(all.begin(), all.begin() + (k - 1), all.end(), greater<>());
+        introQuickSort(all.begin(), all.begin() + k, greater<>());
+        top.assign(all.begin(), all.begin() + k);
+    }, cfg);
+    if (top != best) {
+        cerr << "Error: load-then-select gives a wrong top " << k << endl;
+        return 1;
+    }
+    printRow(loaded, csv);
+    cout << "(streaming keeps " << fixed << setprecision(2)
+         << (k * sizeof(int) + (64 << 10) * sizeof(int)) / 1048576.0 << " MiB, loading keeps "
+         << n * sizeof(int) / 1048576.0 << " MiB)" << defaultfloat << endl;
+    remove(path.c_str());
+
+    cout << "\nResults appended to " << csv.path() << endl;
+    return 0;
+}
@@ -0,0 +1,351 @@
+// ===================================================================
+//              SELECTION: ORDER STATISTICS, PERCENTILES, TOP-K
+// ===================================================================
+//
+// One order statistic (a median, a p99) or the k largest elements
+// without sorting everything:
+//
+//   introSelect()   -> the element of one rank, in place, O(n)
+//   multiSelect()   -> the elements of many ranks in one pass
+//   percentiles()   -> multiSelect() at nearest-rank percentiles
+//   TopK            -> the k largest of a stream, O(k) memory
+//   topKOfFile()    -> TopK over a binary int file of any size
+//
+// Key Notes:
+// - introSelect() is quickselect with the pivots of quickSort.h
+//   (median-of-3 / ninther), recursing only into the side that holds
+//   the rank. Expected O(n).
+// - The partition is two-way and, for ints and other small plain
+//   types, branch-free (every element is written, the count advances
+//   by the comparison). The keys equal to the pivot get a second pass
+//   only when the split is lopsided, as in parallelQuickSort(); the
+//   three-way partition3() of the sort costs a mispredicted branch per
+//   element on random input, which a selection cannot amortise.
+// - Like introQuickSort(), it counts its depth: after 2*log2(n)
+//   partitions it switches to MEDIAN-OF-MEDIANS pivots (the median of
+//   the medians of groups of 5). Those leave at most 7n/10 keys below
+//   and 7n/10 above the pivot; since the two-way partition only splits
+//   off the keys equal to it once the upper side exceeds 3n/4, the
+//   side that is kept holds at most 3n/4, so the worst case is O(n) as
+//   well.
+// - multiSelect() partitions once per level and sends each rank to
+//   the side that holds it: p pivots cost about n log p compares
+//   instead of p full selections. Ranks that fall on the pivot's run
+//   of equal keys are finished without going further.
+// - Afterwards the range is partitioned around every requested rank,
+//   exactly as std::nth_element leaves it (ranks are 0-based).
+// - TopK keeps a min-heap of the k best elements seen so far. Once it
+//   is full, an element that is not better than the heap's top is
+//   rejected with one comparison, which is the common case on long
+//   streams: O(n + k log k log(n/k)) expected on random input.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "ordering.h"   // Identity, projectedLess()
+#include "quickSort.h"  // quicksort_detail::choosePivot()
+#include "smallSort.h"  // smallSort(), smallSortCutoff()
+
+namespace select_detail {
+
+// Elements per group of median-of-medians.
+constexpr ptrdiff_t kGroup = 5;
+
+template <class It, class Less>
+inline void selectLoop(It a, ptrdiff_t n, ptrdiff_t k, int depthLimit, Less less);
+
+/**
+ * @brief Median of the medians of the groups of 5 in a[0, n): a pivot
+ *        with at least 3n/10 elements on either side of it. Moves the
+ *        group medians to the front of the range.
+ */
+template <class It, class Less>
+inline auto medianOfMedians(It a, ptrdiff_t n, Less less) {
+    ptrdiff_t groups = n / kGroup;
+    for (ptrdiff_t g = 0; g < groups; ++g) {
+        It group = a + g * kGroup;
+        smallsort_detail::insertionSort(group, kGroup, less);
+        std::iter_swap(a + g, group + kGroup / 2);
+    }
+    selectLoop(a, groups, groups / 2, 0, less);  // depth 0: medians of medians all the way down
+    return typename std::iterator_traits<It>::value_type(a[groups / 2]);
+}
+
+/**
+ * @brief Pivot of a range at @p depthLimit (0 = guaranteed split).
+ */
+template <class It, class Less>
+inline auto selectPivot(It a, ptrdiff_t n, int depthLimit, Less less) {
+    using T = typename std::iterator_traits<It>::value_type;
+    return depthLimit == 0 ? medianOfMedians(a, n, less) : T(quicksort_detail::choosePivot(a, n, less));
+}
+
+/**
+ * @brief Moves the elements with pred(x) to the front of a[0, n) and
+ *        returns their count. Not stable. Small trivially copyable
+ *        types (ints, doubles, pairs of them) use a Lomuto loop that
+ *        writes every element unconditionally, so random input costs no
+ *        branch mispredictions; other types use std::partition.
+ */
+template <class It, class Pred>
+inline ptrdiff_t partitionBy(It a, ptrdiff_t n, Pred pred) {
+    using T = typename std::iterator_traits<It>::value_type;
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= 16) {
+        ptrdiff_t count = 0;
+        for (ptrdiff_t i = 0; i < n; ++i) {
+            T x = a[i];
+            bool below = pred(x);
+            a[i] = a[count];
+            a[count] = x;
+            count += below;
+        }
+        return count;
+    } else {
+        return std::partition(a, a + n, pred) - a;
+    }
+}
+
+/**
+ * @brief Partitions a[0, n) around @p pivot, which must be one of its
+ *        elements: afterwards a[0, lt) < pivot, and a[lt, gt) == pivot
+ *        if gt > lt. Only a lopsided split (more than 3/4 not below the
+ *        pivot, usually many copies of it) pays for the second pass
+ *        that separates the equal keys, as in parallelQuickSort().
+ */
+template <class It, class T, class Less>
+inline void partitionAround(It a, ptrdiff_t n, const T& pivot, ptrdiff_t& lt, ptrdiff_t& gt, Less less) {
+    lt = partitionBy(a, n, [&](const T& x) { return less(x, pivot); });
+    gt = lt;
+    if (n - lt > n / 4 * 3) gt += partitionBy(a + lt, n - lt, [&](const T& x) { return !less(pivot, x); });
+}
+
+/**
+ * @brief Puts the element of rank k of a[0, n) at a[k], smaller ones
+ *        before it and larger ones after it.
+ */
+template <class It, class Less>
+inline void selectLoop(It a, ptrdiff_t n, ptrdiff_t k, int depthLimit, Less less) {
+    while (n > smallSortCutoff<It, Less>()) {
+        const auto pivot = selectPivot(a, n, depthLimit, less);
+        if (depthLimit > 0) --depthLimit;
+        ptrdiff_t lt, gt;
+        partitionAround(a, n, pivot, lt, gt, less);
+
+        if (k < lt) {
+            n = lt;
+        } else if (k >= gt) {
+            a += gt;
+            n -= gt;
+            k -= gt;
+        } else {
+            return;  // k is on the run of keys equal to the pivot
+        }
+    }
+    smallSort(a, n, less);
+}
+
+/**
+ * @brief selectLoop() for the sorted, distinct ranks [r, rEnd) of
+ *        a[0, n) at once.
+ */
+template <class It, class Less>
+inline void multiSelectLoop(It a, ptrdiff_t n, ptrdiff_t* r, ptrdiff_t* rEnd, int depthLimit, Less less) {
+    while (r != rEnd) {
+        if (rEnd - r == 1) {
+            selectLoop(a, n, *r, depthLimit, less);
+            return;
+        }
+        if (n <= smallSortCutoff<It, Less>()) {
+            smallSort(a, n, less);
+            return;
+        }
+        const auto pivot = selectPivot(a, n, depthLimit, less);
+        if (depthLimit > 0) --depthLimit;
+        ptrdiff_t lt, gt;
+        partitionAround(a, n, pivot, lt, gt, less);
+
+        // Ranks below lt go left, ranks from gt on go right (made
+        // relative to a + gt); the ones in between are in place.
+        ptrdiff_t* leftEnd = std::lower_bound(r, rEnd, lt);
+        ptrdiff_t* rightBegin = std::lower_bound(leftEnd, rEnd, gt);
+        for (ptrdiff_t* x = rightBegin; x != rEnd; ++x) *x -= gt;
+
+        // Recurse into the side with fewer ranks, loop on the other.
+        if (leftEnd - r < rEnd - rightBegin) {
+            multiSelectLoop(a, lt, r, leftEnd, depthLimit, less);
+            a += gt;
+            n -= gt;
+            r = rightBegin;
+        } else {
+            multiSelectLoop(a + gt, n - gt, rightBegin, rEnd, depthLimit, less);
+            n = lt;
+            rEnd = leftEnd;
+        }
+    }
+}
+
+inline int depthLimitFor(ptrdiff_t n) { return n < 2 ? 0 : 2 * (int)std::log2((double)n); }
+
+}  // namespace select_detail
+
+// ===================================================================
+//                          INTROSELECT
+// ===================================================================
+
+/**
+ * @brief Rearranges [first, last) so that *nth is the element a full
+ *        sort would put there, with no greater element before it and
+ *        no smaller one after it (the contract of std::nth_element).
+ *        O(n) worst case.
+ * @param comp Comparator on keys (default ascending)
+ * @param proj Projection from element to key (default the element)
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline void introSelect(RandomIt first, RandomIt nth, RandomIt last, Compare comp = {}, Proj proj = {}) {
+    ptrdiff_t n = last - first;
+    if (nth == last || n < 2) return;
+    select_detail::selectLoop(first, n, nth - first, select_detail::depthLimitFor(n), projectedLess(comp, proj));
+}
+
+/**
+ * @brief introSelect() for many ranks at once: afterwards, for every
+ *        rank r in @p ranks (0-based, any order, duplicates allowed),
+ *        first[r] is the element of rank r, and the range is
+ *        partitioned around it.
+ */
+template <class RandomIt, class Compare = std::less<>, class Proj = Identity>
+inline void multiSelect(RandomIt first, RandomIt last, const std::vector<size_t>& ranks, Compare comp = {},
+                        Proj proj = {}) {
+    ptrdiff_t n = last - first;
+    std::vector<ptrdiff_t> r;
+    for (size_t x : ranks)
+        if (x < (size_t)n) r.push_back((ptrdiff_t)x);
+    std::sort(r.begin(), r.end());
+    r.erase(std::unique(r.begin(), r.end()), r.end());
+    if (n < 2 || r.empty()) return;
+    select_detail::multiSelectLoop(first, n, r.data(), r.data() + r.size(), select_detail::depthLimitFor(n),
+                                   projectedLess(comp, proj));
+}
+
+/**
+ * @brief 0-based rank of the nearest-rank percentile @p p (0 ... 100)
+ *        of n elements, as bench::percentile() picks it.
+ */
+inline size_t percentileRank(double p, size_t n) {
+    size_t rank = (size_t)std::ceil(p / 100.0 * (double)n);
+    return std::min(std::max<size_t>(rank, 1), n) - 1;
+}
+
+/**
+ * @brief Nearest-rank percentiles of @p data (reordered in place, as by
+ *        multiSelect()).
+ * @param ps Percentiles, 0 ... 100.
+ * @return One value per entry of @p ps, in the same order.
+ */
+template <class T, class Compare = std::less<>, class Proj = Identity>
+inline std::vector<T> percentiles(std::vector<T>& data, const std::vector<double>& ps, Compare comp = {},
+                                  Proj proj = {}) {
+    if (data.empty()) return {};
+    std::vector<size_t> ranks;
+    for (double p : ps) ranks.push_back(percentileRank(p, data.size()));
+    multiSelect(data.begin(), data.end(), ranks, comp, proj);
+    std::vector<T> out;
+    for (size_t r : ranks) out.push_back(data[r]);
+    return out;
+}
+
+// ===================================================================
+//                        STREAMING TOP-K
+// ===================================================================
+
+/**
+ * @brief The k largest elements (by comp / proj) of everything pushed.
+ *        Ties at the boundary keep an arbitrary subset.
+ */
+template <class T, class Compare = std::less<>, class Proj = Identity>
+class TopK {
+public:
+    explicit TopK(size_t k, Compare comp = {}, Proj proj = {}) : k_(k), less_(projectedLess(comp, proj)) {
+        heap_.reserve(k);
+    }
+
+    void push(const T& x) {
+        if (heap_.size() < k_) {
+            heap_.push_back(x);
+            std::push_heap(heap_.begin(), heap_.end(), greater());
+        } else if (k_ > 0 && less_(heap_.front(), x)) {
+            // Replace the smallest kept element.
+            std::pop_heap(heap_.begin(), heap_.end(), greater());
+            heap_.back() = x;
+            std::push_heap(heap_.begin(), heap_.end(), greater());
+        }
+    }
+
+    template <class It>
+    void push(It first, It last) {
+        for (; first != last; ++first) push(*first);
+    }
+
+    size_t k() const { return k_; }
+    size_t size() const { return heap_.size(); }
+    bool full() const { return heap_.size() == k_; }
+
+    /**
+     * @brief Smallest element kept: what the next one has to beat.
+     */
+    const T& threshold() const { return heap_.front(); }
+
+    /**
+     * @brief The kept elements, largest first.
+     */
+    std::vector<T> sorted() const {
+        std::vector<T> out = heap_;
+        std::sort_heap(out.begin(), out.end(), greater());
+        return out;
+    }
+
+private:
+    auto greater() const {
+        return [this](const T& x, const T& y) { return less_(y, x); };
+    }
+
+    size_t k_;
+    ProjectedLess<Compare, Proj> less_;
+    std::vector<T> heap_;  // min-heap: the front is the smallest kept
+};
+
+/**
+ * @brief The @p k largest ints of a raw native-endian int file (the
+ *        format of externalSort.h), read in blocks of @p blockElems:
+ *        memory is O(k + blockElems) for a file of any size.
+ * @return false (with a message on stderr) if the file cannot be read
+ *         or its size is not a multiple of sizeof(int).
+ */
+inline bool topKOfFile(const std::string& path, size_t k, std::vector<int>& out, size_t blockElems = 1 << 16) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        std::cerr << "Error: " << path << " not found" << std::endl;
+        return false;
+    }
+    if (in.tellg() % (std::streamoff)sizeof(int) != 0) {
+        std::cerr << "Error: " << path << " is not a whole number of ints" << std::endl;
+        return false;
+    }
+    in.seekg(0);
+
+    TopK<int> top(k);
+    std::vector<int> block(std::max<size_t>(1, blockElems));
+    while (in) {
+        in.read(reinterpret_cast<char*>(block.data()), (std::streamsize)(block.size() * sizeof(int)));
+        size_t count = (size_t)in.gcount() / sizeof(int);
+        top.push(block.begin(), block.begin() + count);
+    }
+    if (in.bad()) {
+        std::cerr << "Error: could not read " << path << std::endl;
+        return false;
+    }
+    out = top.sorted();
+    return true;
+}
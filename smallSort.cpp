@@ -0,0 +1,137 @@
+// ===================================================================
+//               SMALL-SORT KERNELS BENCHMARK PROGRAM
+// ===================================================================
+//
+// Throughput of the small-sort kernels of smallSort.h on MANY small
+// arrays, the shape of work they get at the bottom of a quick sort or
+// merge sort, and their effect on those sorts.
+//
+// Usage: ./smallSort [N]     (default N = 1000000 ints per sample)
+//
+// Key Notes:
+// - Section 1: N random ints cut into arrays of 4 ... 64 elements;
+//   every kernel sorts all of them, and the time is reported per
+//   array and per element:
+//     * insertion sort (classic, branchy),
+//     * branchlessInsertionSort(),
+//     * sortNetwork() (AVX2 when built with -march=native),
+//     * std::sort, for reference.
+// - Section 2: introQuickSort() and parallelMergeSort() (1 thread) on
+//   N ints, with std::less<> (sorting networks below the cutoff) and
+//   with an equivalent lambda, which the kernels cannot recognise and
+//   finish with branchlessInsertionSort().
+// - Every result is checked against std::sort.
+//
+// Build: g++ -O2 -march=native -pthread smallSort.cpp -o smallSort
+//
+// ===================================================================
+
+#include <bits/stdc++.h>
+#include "benchmark.h"         // Shared timing harness + CSV writer
+#include "datasetGenerator.h"  // loadDataset()
+#include "mergeSort.h"         // parallelMergeSort()
+#include "quickSort.h"         // introQuickSort()
+#include "smallSort.h"         // sortNetwork(), branchlessInsertionSort()
+using namespace std;
+
+/**
+ * @brief Sorts every consecutive array of @p size ints of @p data
+ *        (the last one may be shorter) with @p kernel.
+ */
+template <class Kernel>
+void sortArrays(vector<int>& data, size_t size, Kernel kernel) {
+    for (size_t i = 0; i < data.size(); i += size) kernel(data.data() + i, min(size, data.size() - i));
+}
+
+// ===================================================================
+//                          MAIN FUNCTION
+// ===================================================================
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? stoull(argv[1]) : 1000000;
+    bench::ResultWriter csv;
+    if (!csv.isOpen()) {
+        cerr << "Error: Could not open " << csv.path() << endl;
+        return 1;
+    }
+
+    bench::Config cfg;
+    cfg.warmupSamples = 1;
+    cfg.samples = 10;
+
+    DatasetSpec spec{Distribution::Uniform, n};
+    spec.maxValue = numeric_limits<int>::max();
+    const vector<int> input = loadDataset(spec);
+    vector<int> data;
+
+#ifdef __AVX2__
+    const char* isa = "AVX2";
+#else
+    const char* isa = "scalar";
+#endif
+
+    // ---- section 1: many small arrays ----
+    cout << "--- Small-sort kernels on " << n << " ints (networks: " << isa << ") ---\n" << endl;
+    cout << left << setw(34) << "Kernel" << right << setw(6) << "size" << setw(14) << "ns / array" << setw(14)
+         << "ns / element" << endl;
+
+    auto less = projectedLess(std::less<>(), Identity());
+    for (size_t size : {4, 8, 16, 24, 32, 48, 64}) {
+        vector<int> expected = input;
+        sortArrays(expected, size, [](int* a, size_t k) { sort(a, a + k); });
+
+        // A generic lambda, so every kernel is inlined into its loop.
+        auto run = [&](const string& name, auto kernel) {
+            bench::Stats stats = bench::measureWithSetup(
+                "SmallSort_" + name + "_" + to_string(size), (long long)n,
+                [&] { data = input; },
+                [&] { sortArrays(data, size, kernel); }, cfg);
+            if (data != expected) {
+                cerr << "Error: " << name << " produced a wrong result on arrays of " << size << endl;
+                return false;
+            }
+            double arrays = (double)((n + size - 1) / size);
+            cout << left << setw(34) << stats.algorithm << right << setw(6) << size << fixed << setprecision(1)
+                 << setw(14) << stats.medianNs / arrays << setw(14) << setprecision(2) << stats.medianNs / (double)n
+                 << defaultfloat << endl;
+            csv.write(stats);
+            return true;
+        };
+        if (!run("Insertion", [&](int* a, size_t k) { smallsort_detail::insertionSort(a, (ptrdiff_t)k, less); }) ||
+            !run("BranchlessInsertion", [&](int* a, size_t k) { branchlessInsertionSort(a, (ptrdiff_t)k, less); }) ||
+            !run("SortNetwork", [](int* a, size_t k) { sortNetwork(a, k); }) ||
+            !run("StdSort", [](int* a, size_t k) { sort(a, a + k); }))
+            return 1;
+        cout << endl;
+    }
+
+    // ---- section 2: inside the full sorts ----
+    cout << "--- Full sorts of " << n << " ints (1 thread) ---\n" << endl;
+    vector<int> expected = input;
+    sort(expected.begin(), expected.end());
+    ThreadPool pool(1);
+    auto plainLess = [](int a, int b) { return a < b; };
+
+    vector<pair<string, function<void()>>> sorts = {
+        {"IntroQuickSort_network", [&] { introQuickSort(data.begin(), data.end()); }},
+        {"IntroQuickSort_insertion", [&] { introQuickSort(data.begin(), data.end(), plainLess); }},
+        {"ParallelMergeSort_network", [&] { parallelMergeSort(data, pool); }},
+        {"ParallelMergeSort_insertion", [&] { parallelMergeSort(data, pool, plainLess); }},
+    };
+    for (auto& [name, sortAll] : sorts) {
+        bench::Stats stats = bench::measureWithSetup(
+            name, (long long)n,
+            [&] { data = input; },
+            [&] { sortAll(); }, cfg);
+        if (data != expected) {
+            cerr << "Error: " << name << " produced a wrong result" << endl;
+            return 1;
+        }
+        cout << setw(30) << left << stats.algorithm << right;
+        bench::printStats(stats);
+        csv.write(stats);
+    }
+
+    cout << "\nResults appended to " << csv.path() << endl;
+    return 0;
+}
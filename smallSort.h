@@ -0,0 +1,292 @@
+// ===================================================================
+//                 SMALL-SORT KERNELS (SORTING NETWORKS)
+// ===================================================================
+//
+// Base case of quickSort.h and mergeSort.h: both recurse until a range
+// is below a small cutoff and then hand it to smallSort(). Sorting
+// tiny ranges is a large share of their run time, and the plain
+// insertion sort spends it on mispredicted branches.
+//
+//   sortNetwork()             -> up to 64 ints, padded to a bitonic
+//                                network of 8, 16, 32 or 64 elements
+//   branchlessInsertionSort() -> integer keys, any comparator
+//   smallSort()               -> picks the right one for the range
+//
+// Key Notes:
+// - With AVX2 a network keeps 8 ints per register: every compare-
+//   exchange layer is one min + one max (+ one shuffle and one blend
+//   inside a register), and a partial last register is filled up with
+//   masked loads, so a sort of up to 64 ints has no branches on the
+//   data at all. Without AVX2 sortNetwork() still works, on scalars in
+//   a padded buffer, but it is several times slower than
+//   branchlessInsertionSort(), so smallSort() does not use it there.
+// - The network is only used for int ranges in ascending order with
+//   no projection: it is not stable, and equal ints cannot be told
+//   apart, so stable callers (merge sort) stay stable.
+// - branchlessInsertionSort() moves an element down by compare-
+//   exchanging neighbours without ever leaving the loop early, which
+//   costs more comparisons but no mispredictions. It only swaps when
+//   strictly out of order, so it is stable.
+// - Other element types get the classic insertion sort: for records
+//   the selects copy whole elements, and for floats GCC does not turn
+//   them into conditional moves, so branchless is slower there.
+// - Both cutoffs can be tuned at build time:
+//       -DSMALL_SORT_NETWORK_CUTOFF=N   ints with AVX2, N <= 64 (default 64)
+//       -DSMALL_SORT_CUTOFF=N           everything else (default 16)
+// - Build with -march=native (or -mavx2) to enable the AVX2 path.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+#include "ordering.h"  // Identity, ProjectedLess
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#ifndef SMALL_SORT_NETWORK_CUTOFF
+#define SMALL_SORT_NETWORK_CUTOFF 64
+#endif
+#ifndef SMALL_SORT_CUTOFF
+#define SMALL_SORT_CUTOFF 16
+#endif
+
+static_assert(SMALL_SORT_NETWORK_CUTOFF <= 64, "sorting networks cover at most 64 ints");
+
+namespace smallsort_detail {
+
+constexpr size_t kMaxNetwork = 64;
+
+#ifdef __AVX2__
+
+/**
+ * @brief Lanes that keep the larger value when lane i is compared with
+ *        lane i ^ j in the bitonic stage building sorted runs of k
+ *        (runs alternate ascending / descending; k = 8 is all ascending).
+ */
+constexpr int maxLanes(int j, int k) {
+    int mask = 0;
+    for (int i = 0; i < 8; ++i) {
+        bool ascending = (i & k) == 0 || k == 8;
+        bool upper = (i & j) != 0;
+        if (upper == ascending) mask |= 1 << i;
+    }
+    return mask;
+}
+
+/**
+ * @brief One compare-exchange layer inside a register.
+ */
+template <int J, int K>
+inline __m256i layer(__m256i v) {
+    __m256i p;
+    if constexpr (J == 1) p = _mm256_shuffle_epi32(v, 0xB1);
+    else if constexpr (J == 2) p = _mm256_shuffle_epi32(v, 0x4E);
+    else p = _mm256_permute2x128_si256(v, v, 0x01);
+    return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), maxLanes(J, K));
+}
+
+inline __m256i sort8(__m256i v) {
+    v = layer<1, 2>(v);
+    v = layer<2, 4>(v);
+    v = layer<1, 4>(v);
+    v = layer<4, 8>(v);
+    v = layer<2, 8>(v);
+    return layer<1, 8>(v);
+}
+
+inline __m256i reverse8(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+/**
+ * @brief Sorts the 8*R ints held in v[0, R) ascending.
+ */
+template <int R>
+inline void sortRegisters(__m256i* v) {
+    if constexpr (R == 1) {
+        v[0] = sort8(v[0]);
+    } else {
+        sortRegisters<R / 2>(v);
+        sortRegisters<R / 2>(v + R / 2);
+
+        // Reversing the upper half makes the whole sequence bitonic.
+        for (int r = 0; r < R / 4; ++r) {
+            __m256i t = reverse8(v[R / 2 + r]);
+            v[R / 2 + r] = reverse8(v[R - 1 - r]);
+            v[R - 1 - r] = t;
+        }
+        if constexpr (R == 2) v[1] = reverse8(v[1]);
+
+        // Half-cleaners: across registers first, then inside them.
+        for (int d = R / 2; d >= 1; d /= 2) {
+            for (int r = 0; r < R; ++r) {
+                if (r & d) continue;
+                __m256i lo = _mm256_min_epi32(v[r], v[r + d]);
+                v[r + d] = _mm256_max_epi32(v[r], v[r + d]);
+                v[r] = lo;
+            }
+        }
+        for (int r = 0; r < R; ++r) v[r] = layer<1, 8>(layer<2, 8>(layer<4, 8>(v[r])));
+    }
+}
+
+/**
+ * @brief Loads a[0, count) into a register, padding the lanes from
+ *        count on with INT_MAX; masked lanes are never read.
+ */
+inline __m256i loadPadded(const int* a, ptrdiff_t count) {
+    if (count >= 8) return _mm256_loadu_si256((const __m256i*)a);
+    __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)std::max<ptrdiff_t>(count, 0)),
+                                      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i v = _mm256_maskload_epi32(a, mask);
+    return _mm256_blendv_epi8(_mm256_set1_epi32(std::numeric_limits<int>::max()), v, mask);
+}
+
+inline void storePartial(int* a, ptrdiff_t count, __m256i v) {
+    if (count >= 8) {
+        _mm256_storeu_si256((__m256i*)a, v);
+    } else if (count > 0) {
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)count), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        _mm256_maskstore_epi32(a, mask, v);
+    }
+}
+
+/**
+ * @brief Sorts a[0, n), n <= N, with the network of N ints.
+ */
+template <int N>
+inline void network(int* a, ptrdiff_t n) {
+    constexpr int R = N / 8;
+    __m256i v[R];
+    for (int r = 0; r < R; ++r) v[r] = loadPadded(a + 8 * r, n - 8 * r);
+    sortRegisters<R>(v);
+    for (int r = 0; r < R; ++r) storePartial(a + 8 * r, n - 8 * r, v[r]);
+}
+
+#else
+
+/**
+ * @brief Scalar bitonic network over N ints (N a power of two).
+ */
+template <int N>
+inline void bitonic(int* a) {
+    for (int k = 2; k <= N; k *= 2) {
+        for (int j = k / 2; j >= 1; j /= 2) {
+            for (int i = 0; i < N; ++i) {
+                int partner = i ^ j;
+                if (partner < i) continue;
+                int lo = std::min(a[i], a[partner]), hi = std::max(a[i], a[partner]);
+                bool ascending = (i & k) == 0;
+                a[i] = ascending ? lo : hi;
+                a[partner] = ascending ? hi : lo;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sorts a[0, n), n <= N, with the network of N ints.
+ */
+template <int N>
+inline void network(int* a, ptrdiff_t n) {
+    int padded[N];
+    std::copy(a, a + n, padded);
+    std::fill(padded + n, padded + N, std::numeric_limits<int>::max());
+    bitonic<N>(padded);
+    std::copy(padded, padded + n, a);
+}
+
+#endif
+
+/**
+ * @brief True when [It, Less] is a range of ints in plain ascending
+ *        order, where a network gives the same result as a stable sort,
+ *        and the network is vectorised.
+ */
+template <class It, class Less>
+constexpr bool networkSortable =
+#ifdef __AVX2__
+    (std::is_same_v<It, int*> || std::is_same_v<It, std::vector<int>::iterator>) &&
+    (std::is_same_v<Less, ProjectedLess<std::less<>, Identity>> ||
+     std::is_same_v<Less, ProjectedLess<std::less<int>, Identity>>);
+#else
+    false;  // the scalar network loses to branchlessInsertionSort()
+#endif
+
+template <class It, class Less>
+inline void insertionSort(It a, ptrdiff_t n, Less less) {
+    for (ptrdiff_t i = 1; i < n; ++i) {
+        auto key = std::move(a[i]);
+        ptrdiff_t j = i;
+        while (j > 0 && less(key, a[j - 1])) {
+            a[j] = std::move(a[j - 1]);
+            --j;
+        }
+        a[j] = std::move(key);
+    }
+}
+
+}  // namespace smallsort_detail
+
+/**
+ * @brief Sorts a[0, n) ascending, n <= 64, with a sorting network. The
+ *        range is padded with INT_MAX up to the next network size.
+ */
+inline void sortNetwork(int* a, size_t n) {
+    using namespace smallsort_detail;
+    ptrdiff_t count = (ptrdiff_t)n;
+    if (n < 2) return;
+    if (n <= 8) network<8>(a, count);
+    else if (n <= 16) network<16>(a, count);
+    else if (n <= 32) network<32>(a, count);
+    else network<64>(a, count);
+}
+
+/**
+ * @brief Stable insertion sort without data-dependent branches: every
+ *        element is compare-exchanged all the way down to position 0.
+ *        Meant for integers and a few dozen elements.
+ */
+template <class It, class Less>
+inline void branchlessInsertionSort(It a, ptrdiff_t n, Less less) {
+    for (ptrdiff_t i = 1; i < n; ++i) {
+        for (ptrdiff_t j = i; j > 0; --j) {
+            auto x = a[j - 1], y = a[j];
+            bool swap = less(y, x);
+            a[j - 1] = swap ? y : x;
+            a[j] = swap ? x : y;
+        }
+    }
+}
+
+/**
+ * @brief Largest range the sorts hand to smallSort() for this element
+ *        order.
+ */
+template <class It, class Less>
+constexpr ptrdiff_t smallSortCutoff() {
+    return smallsort_detail::networkSortable<It, Less> ? SMALL_SORT_NETWORK_CUTOFF : SMALL_SORT_CUTOFF;
+}
+
+/**
+ * @brief Sorts the small range a[0, n) with the best kernel for its
+ *        type: a network for plain ints, branchless insertion sort for
+ *        other integers, insertion sort otherwise. Stable
+ *        except where stability cannot be observed.
+ */
+template <class It, class Less>
+inline void smallSort(It a, ptrdiff_t n, Less less) {
+    using T = typename std::iterator_traits<It>::value_type;
+    if (n < 2) return;
+    if constexpr (smallsort_detail::networkSortable<It, Less>) {
+        if (n <= (ptrdiff_t)smallsort_detail::kMaxNetwork) {
+            sortNetwork(&*a, (size_t)n);
+            return;
+        }
+    }
+    if constexpr (std::is_integral_v<T>) branchlessInsertionSort(a, n, less);
+    else smallsort_detail::insertionSort(a, n, less);
+}
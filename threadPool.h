@@ -0,0 +1,198 @@
+// ===================================================================
+//                    WORK-STEALING THREAD POOL
+// ===================================================================
+//
+// A small fork-join pool shared by the parallel algorithms in this
+// repository (parallel merge sort, parallel scans, ...).
+//
+// Key Notes:
+// - Every worker owns a deque. A worker pushes and pops new tasks at
+//   the back (LIFO, cache-warm) and idle workers steal from the front
+//   of someone else's deque (FIFO, the biggest pieces of work first).
+// - Threads that are not pool workers (e.g. main) share one extra
+//   "external" deque, so they can submit work too.
+// - TaskGroup::wait() never just blocks: the waiting thread keeps
+//   running queued tasks until its group is done. This is what makes
+//   recursive divide-and-conquer (spawn, spawn, wait) deadlock-free.
+// - A pool of size T uses T-1 background workers plus the thread that
+//   calls wait(), so ThreadPool(1) runs everything on the caller.
+//
+// ===================================================================
+
+#pragma once
+
+#include <bits/stdc++.h>
+
+class ThreadPool {
+public:
+    /**
+     * @brief Creates a pool in which @p threads threads take part in the
+     *        work (the caller of wait() counts as one of them).
+     */
+    explicit ThreadPool(unsigned threads = std::max(1u, std::thread::hardware_concurrency()))
+        : threads_(std::max(1u, threads)), queues_(threads_) {
+        // queues_[0 .. threads_-2] belong to workers, the last one is shared
+        // by every external thread.
+        for (unsigned i = 0; i + 1 < threads_; ++i)
+            workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        sleepCv_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Number of threads that execute tasks (workers + caller).
+     */
+    unsigned size() const { return threads_; }
+
+    /**
+     * @brief A set of tasks that can be waited on together.
+     */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& pool) : pool_(pool) {}
+        ~TaskGroup() { wait(); }
+
+        /**
+         * @brief Queues @p task on the calling thread's deque.
+         */
+        void run(std::function<void()> task) {
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            pool_.push([this, task = std::move(task)] {
+                task();
+                pending_.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        /**
+         * @brief Returns once every task of this group has finished,
+         *        executing other queued tasks in the meantime.
+         */
+        void wait() {
+            while (pending_.load(std::memory_order_acquire) != 0) {
+                if (!pool_.runOne()) std::this_thread::yield();
+            }
+        }
+
+    private:
+        ThreadPool& pool_;
+        std::atomic<long> pending_{0};
+    };
+
+    /**
+     * @brief Runs body(lo, hi) over [begin, end) split into chunks of at
+     *        least @p grain elements, and waits for all of them.
+     */
+    template <class Body>
+    void parallelFor(size_t begin, size_t end, size_t grain, Body&& body) {
+        if (end <= begin) return;
+        size_t n = end - begin;
+        size_t chunks = std::min<size_t>(threads_ * 4, (n + grain - 1) / std::max<size_t>(grain, 1));
+        if (chunks <= 1) {
+            body(begin, end);
+            return;
+        }
+        size_t step = (n + chunks - 1) / chunks;
+        TaskGroup group(*this);
+        for (size_t lo = begin + step; lo < end; lo += step) {
+            size_t hi = std::min(end, lo + step);
+            group.run([&body, lo, hi] { body(lo, hi); });
+        }
+        body(begin, std::min(end, begin + step));
+        group.wait();
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Which deque the current thread owns in which pool.
+    static inline thread_local ThreadPool* tlsPool_ = nullptr;
+    static inline thread_local unsigned tlsIndex_ = 0;
+
+    unsigned myIndex() const {
+        return tlsPool_ == this ? tlsIndex_ : threads_ - 1;
+    }
+
+    void push(std::function<void()> task) {
+        Queue& q = queues_[myIndex()];
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+        if (sleeping_.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            sleepCv_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Pops from the own deque, otherwise steals from the others.
+     * @return true if a task was executed.
+     */
+    bool runOne() {
+        if (queued_.load(std::memory_order_acquire) == 0) return false;
+
+        unsigned me = myIndex();
+        std::function<void()> task;
+        {
+            Queue& q = queues_[me];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }
+        }
+        for (unsigned k = 1; !task && k < threads_; ++k) {
+            Queue& victim = queues_[(me + k) % threads_];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+        if (!task) return false;
+
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    void workerLoop(unsigned index) {
+        tlsPool_ = this;
+        tlsIndex_ = index;
+        while (true) {
+            if (runOne()) continue;
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleeping_.fetch_add(1, std::memory_order_acq_rel);
+            sleepCv_.wait_for(lock, std::chrono::milliseconds(1), [this] {
+                return stop_ || queued_.load(std::memory_order_acquire) > 0;
+            });
+            sleeping_.fetch_sub(1, std::memory_order_acq_rel);
+            if (stop_) return;
+        }
+    }
+
+    unsigned threads_;
+    std::vector<Queue> queues_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<long> queued_{0};
+    std::atomic<int> sleeping_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    bool stop_ = false;
+};